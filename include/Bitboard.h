@@ -0,0 +1,252 @@
+#pragma once
+#include <array>
+#include <type_traits>
+#include <cstddef>
+#include <cstdint>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+
+/**
+	Gets the index of the lowest set bit of a non-zero bitmask.
+*/
+inline unsigned int lowestBitIndex(uint64_t bits) {
+#if defined(_MSC_VER)
+	unsigned long idx;
+	_BitScanForward64(&idx, bits);
+	return static_cast<unsigned int>(idx);
+#else
+	return static_cast<unsigned int>(__builtin_ctzll(bits));
+#endif
+}
+
+
+/**
+	Gets the number of set bits of a bitmask, i.e. the number of pegs of a board.
+*/
+inline unsigned int pegCount(uint64_t bits) {
+#if defined(_MSC_VER)
+	return static_cast<unsigned int>(__popcnt64(bits));
+#else
+	return static_cast<unsigned int>(__builtin_popcountll(bits));
+#endif
+}
+
+
+/**
+	Bitboard of several 64 bit words for boards whose grid does not fit into a single word.
+	Bit i is stored in bit i % 64 of word i / 64. All operations loop over the words with a constant trip count,
+	which the compiler unrolls (and vectorizes where the target allows it), so no 128 bit integer type is needed.
+	Boards fitting into 64 bits keep using uint64_t directly (see BitboardFor).
+*/
+template <std::size_t Words>
+struct Bitboard {
+	static_assert(Words > 1, "Boards of a single word use uint64_t.");
+	static constexpr std::size_t kWords = Words;
+
+	std::array<uint64_t, Words> words{};
+
+	constexpr Bitboard& operator&=(const Bitboard& other) {
+		for (std::size_t idx = 0; idx < Words; ++idx) {
+			words[idx] &= other.words[idx];
+		}
+		return *this;
+	}
+
+	constexpr Bitboard& operator|=(const Bitboard& other) {
+		for (std::size_t idx = 0; idx < Words; ++idx) {
+			words[idx] |= other.words[idx];
+		}
+		return *this;
+	}
+
+	constexpr Bitboard& operator^=(const Bitboard& other) {
+		for (std::size_t idx = 0; idx < Words; ++idx) {
+			words[idx] ^= other.words[idx];
+		}
+		return *this;
+	}
+
+	constexpr Bitboard operator&(const Bitboard& other) const {
+		Bitboard result = *this;
+		return result &= other;
+	}
+
+	constexpr Bitboard operator|(const Bitboard& other) const {
+		Bitboard result = *this;
+		return result |= other;
+	}
+
+	constexpr Bitboard operator^(const Bitboard& other) const {
+		Bitboard result = *this;
+		return result ^= other;
+	}
+
+	constexpr Bitboard operator~() const {
+		Bitboard result;
+		for (std::size_t idx = 0; idx < Words; ++idx) {
+			result.words[idx] = ~words[idx];
+		}
+		return result;
+	}
+
+	/**
+		Shifts the board towards the higher bits, bits shifted out of the last word are lost.
+	*/
+	constexpr Bitboard operator<<(std::size_t shift) const {
+		Bitboard result;
+		const std::size_t wordShift = shift / 64;
+		const std::size_t bitShift = shift % 64;
+		for (std::size_t idx = wordShift; idx < Words; ++idx) {
+			result.words[idx] = words[idx - wordShift] << bitShift;
+			if (bitShift != 0 && idx > wordShift) {
+				result.words[idx] |= words[idx - wordShift - 1] >> (64 - bitShift);
+			}
+		}
+		return result;
+	}
+
+	/**
+		Shifts the board towards the lower bits.
+	*/
+	constexpr Bitboard operator>>(std::size_t shift) const {
+		Bitboard result;
+		const std::size_t wordShift = shift / 64;
+		const std::size_t bitShift = shift % 64;
+		for (std::size_t idx = 0; idx + wordShift < Words; ++idx) {
+			result.words[idx] = words[idx + wordShift] >> bitShift;
+			if (bitShift != 0 && idx + wordShift + 1 < Words) {
+				result.words[idx] |= words[idx + wordShift + 1] << (64 - bitShift);
+			}
+		}
+		return result;
+	}
+
+	constexpr bool operator==(const Bitboard& other) const {
+		uint64_t difference = 0;
+		for (std::size_t idx = 0; idx < Words; ++idx) {
+			difference |= words[idx] ^ other.words[idx];
+		}
+		return difference == 0;
+	}
+
+	constexpr bool operator!=(const Bitboard& other) const {
+		return !(*this == other);
+	}
+
+	/**
+		Orders the boards like the numbers they represent, used to pick the canonical board among its symmetric images.
+	*/
+	constexpr bool operator<(const Bitboard& other) const {
+		for (std::size_t idx = Words; idx > 0; --idx) {
+			if (words[idx - 1] != other.words[idx - 1]) {
+				return words[idx - 1] < other.words[idx - 1];
+			}
+		}
+		return false;
+	}
+};
+
+
+/**
+	The bitboard type of a board with the given number of bits: uint64_t up to 64 bits, else a Bitboard of enough words.
+*/
+template <std::size_t Bits>
+using BitboardFor = std::conditional_t<Bits <= 64, uint64_t, Bitboard<(Bits + 63) / 64>>;
+
+/**
+	The number of 64 bit words of a bitboard type.
+*/
+template <typename Board>
+inline constexpr std::size_t kBitboardWords = Board::kWords;
+
+template <>
+inline constexpr std::size_t kBitboardWords<uint64_t> = 1;
+
+/**
+	The number of bits of a bitboard type.
+*/
+template <typename Board>
+inline constexpr std::size_t kBitboardBits = 64 * kBitboardWords<Board>;
+
+
+/**
+	Gets a bitboard with only the given bit set.
+*/
+template <typename Board>
+constexpr Board singleBit(std::size_t idx) {
+	if constexpr (std::is_same_v<Board, uint64_t>) {
+		return 1ULL << idx;
+	} else {
+		Board board{};
+		board.words[idx / 64] = 1ULL << (idx % 64);
+		return board;
+	}
+}
+
+/**
+	Gets one 64 bit word of a bitboard.
+*/
+constexpr uint64_t bitboardWord(uint64_t board, std::size_t) {
+	return board;
+}
+
+template <std::size_t Words>
+constexpr uint64_t bitboardWord(const Bitboard<Words>& board, std::size_t wordIdx) {
+	return board.words[wordIdx];
+}
+
+/**
+	Clears the lowest set bit of a bitmask, i.e. steps to the next bit when iterating over the set bits.
+*/
+constexpr uint64_t withoutLowestBit(uint64_t bits) {
+	return bits & (bits - 1);
+}
+
+template <std::size_t Words>
+constexpr Bitboard<Words> withoutLowestBit(Bitboard<Words> bits) {
+	for (std::size_t idx = 0; idx < Words; ++idx) {
+		if (bits.words[idx] != 0) {
+			bits.words[idx] &= bits.words[idx] - 1;
+			break;
+		}
+	}
+	return bits;
+}
+
+template <std::size_t Words>
+unsigned int lowestBitIndex(const Bitboard<Words>& bits) {
+	for (std::size_t idx = 0; idx + 1 < Words; ++idx) {
+		if (bits.words[idx] != 0) {
+			return static_cast<unsigned int>(64 * idx) + lowestBitIndex(bits.words[idx]);
+		}
+	}
+	return static_cast<unsigned int>(64 * (Words - 1)) + lowestBitIndex(bits.words[Words - 1]);
+}
+
+template <std::size_t Words>
+unsigned int pegCount(const Bitboard<Words>& bits) {
+	unsigned int count = 0;
+	for (std::size_t idx = 0; idx < Words; ++idx) {
+		count += pegCount(bits.words[idx]);
+	}
+	return count;
+}
+
+/**
+	Hashes a bitboard to 64 bits, the bucket of a transposition table is given by the highest bits (Fibonacci hashing).
+*/
+constexpr uint64_t bitboardHash(uint64_t board) {
+	return board * 0x9E3779B97F4A7C15ULL;
+}
+
+template <std::size_t Words>
+constexpr uint64_t bitboardHash(const Bitboard<Words>& board) {
+	uint64_t hash = 0;
+	for (std::size_t idx = 0; idx < Words; ++idx) {
+		hash = (hash ^ board.words[idx]) * 0x9E3779B97F4A7C15ULL;
+		hash ^= hash >> 29; // spreads the bits of every word to the low bits, which the next multiplication moves up again
+	}
+	return hash;
+}
@@ -0,0 +1,145 @@
+#pragma once
+#include <array>
+#include <vector>
+#include <string>
+#include <istream>
+#include <memory>
+#include <variant>
+#include <utility>
+#include <cstddef>
+#include <cstdint>
+#include "BoardTables.h"
+#include "BoardLayout.h"
+#include "Bitboard.h"
+
+
+/**
+	Board compiled from a board file: its tables (move table, index maps, goal board) and the layout the solver searches it with.
+	\tparam GridBoard The bitboard type holding the grid of the board
+*/
+template <typename GridBoard>
+struct BasicLoadedBoard {
+	std::string name;
+	BasicBoardTables<GridBoard> tables;
+	std::vector<std::vector<int>> pagodaWeights; // pagoda functions of the board file as weights of the compact bit indices
+	BasicBoardLayout<GridBoard> layout;
+};
+
+using LoadedBoard = BasicLoadedBoard<uint64_t>;
+
+/**
+	A loaded board with the smallest bitboard type its grid fits into.
+*/
+using AnyLoadedBoard = std::variant<
+	std::unique_ptr<const BasicLoadedBoard<uint64_t>>,
+	std::unique_ptr<const BasicLoadedBoard<Bitboard<2>>>,
+	std::unique_ptr<const BasicLoadedBoard<Bitboard<4>>>>;
+
+
+/**
+	Definition of a board read from a text file, so new boards are solved without code changes.
+	The definition is parsed once and compiled into the same tables the built-in boards derive at compile time (see BoardTables.h).
+	The compiled tables are cached in a binary file, which later loads only verify and copy as long as the board file is unchanged.
+
+	Board file format (one statement per line, '#' starts a comment):
+	- name <text>: the name of the board
+	- goal <row> <col> [<row> <col> ...]: the pegs of the goal board (optional if the grid has exactly one empty field, which is the goal)
+	- symmetries <name> ...: the symmetries the solver may use, out of flip-lr, flip-ud, rot180, transpose, antitranspose, rot90, rot270,
+	  or none (optional, by default all symmetries of the fields and the goal board are used)
+	- pagoda <weight> ...: a pagoda function pruning the search, one weight per field row by row (optional, may be repeated)
+	- grid: the rows of the initial board follow, one character per cell ('o': peg, '.': empty field, '-': no field)
+	Rows shorter than the widest row are filled up with cells that are no fields. The grid has at most 254 cells and 16 rows and columns.
+
+	Cache file format (version 1, native byte order):
+	- CacheHeader: grid words, sizes and checksum of the content, checksum of the board file and the name of the board
+	- the BasicBoardTables of the board as they are in memory
+	- the weights of the pagoda functions as 64 bit integers
+*/
+class BoardDefinition {
+public:
+	static constexpr uint32_t kCacheVersion = 1;
+	static constexpr std::size_t kMaxGridLength = 16; // rows and columns of a grid
+	static constexpr std::size_t kMaxNameLength = 63;
+	static constexpr const char* kBoardDirectory = "assets/boards"; // the board files of the game
+
+	/**
+		Layout of the start of a cache file.
+	*/
+	struct CacheHeader {
+		std::array<char, 8> magic{ { 'P', 'E', 'G', 'B', 'O', 'A', 'R', 'D' } };
+		uint32_t version{ kCacheVersion };
+		uint32_t gridWords{ 0 }; // 64 bit words of the bitboard type of the tables
+		uint64_t tablesSize{ 0 }; // sizeof the tables
+		uint64_t pagodaCount{ 0 }; // number of pagoda functions, each with a weight per field
+		uint64_t contentChecksum{ 0 }; // checksum of the tables and the weights
+		uint64_t sourceChecksum{ 0 }; // checksum of the board file the tables were compiled from
+		std::array<char, kMaxNameLength + 1> name{};
+		uint64_t headerChecksum{ 0 }; // checksum of all previous bytes of the header
+	};
+
+	std::string name{};
+	std::size_t rows{ 0 };
+	std::size_t cols{ 0 };
+	std::vector<int> cells{}; // initial state of every cell row by row (-1: no field, 0: empty field, 1: peg)
+	std::vector<std::pair<int, int>> goal{}; // pegs of the goal board
+	uint8_t symmetryGroup{ 0 }; // bit k allows the k-th element of D4 (see BasicBoardTables::transform), 0 allows all symmetries of the board
+	std::vector<std::vector<int>> pagodaWeights{}; // weights of the pagoda functions, one per field row by row
+
+	/**
+		Parses a board file.
+		\param input The content of the board file
+		\param source The name of the board file used in error messages
+		\return The definition of the board
+		\throws std::invalid_argument If the content is no valid board definition, the message names the line
+	*/
+	static BoardDefinition parse(std::istream& input, const std::string& source);
+
+	/**
+		Gets the number of 64 bit words of the smallest bitboard type holding the grid.
+	*/
+	std::size_t gridWords() const {
+		return (rows * cols + 63) / 64;
+	}
+
+	/**
+		Compiles the definition into the tables of the board.
+		\tparam GridBoard The bitboard type, which has to hold the grid (see gridWords())
+		\return The tables of the board
+		\throws std::invalid_argument If the goal board has a peg on no field or a requested symmetry is no symmetry of the fields and the goal board
+	*/
+	template <typename GridBoard>
+	BasicBoardTables<GridBoard> compile() const;
+
+	/**
+		Lists the board files (*.board) of a directory.
+		\param directory The directory
+		\return The paths of the board files sorted by name
+		\throws std::filesystem::filesystem_error If the directory cannot be read
+	*/
+	static std::vector<std::string> listBoardFiles(const std::string& directory);
+
+	/**
+		Gets the default path of the cache file of a board file.
+	*/
+	static std::string defaultCachePath(const std::string& path);
+
+	/**
+		Loads a board file. The tables are taken from the cache file if it was compiled from the same content of the board file,
+		else the board file is compiled and the cache file is (re)written. A cache file which cannot be written is skipped.
+		\param path The path of the board file
+		\param cachePath The path of the cache file
+		\return The loaded board
+		\throws std::runtime_error If the board file cannot be read
+		\throws std::invalid_argument If the board file is no valid board definition
+	*/
+	static AnyLoadedBoard load(const std::string& path, const std::string& cachePath);
+
+	static AnyLoadedBoard load(const std::string& path) {
+		return load(path, defaultCachePath(path));
+	}
+};
+
+// compile() is instantiated in BoardDefinition.cpp for these bitboard types
+extern template BasicBoardTables<uint64_t> BoardDefinition::compile<uint64_t>() const;
+extern template BasicBoardTables<Bitboard<2>> BoardDefinition::compile<Bitboard<2>>() const;
+extern template BasicBoardTables<Bitboard<4>> BoardDefinition::compile<Bitboard<4>>() const;
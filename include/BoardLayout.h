@@ -0,0 +1,241 @@
+#pragma once
+#include <array>
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include "BoardTables.h"
+#include "Move.h"
+#include "Bitboard.h"
+
+
+/**
+	Permutation of the bit indices of a solver board according to one symmetry of the board layout.
+	The image of every byte of the board is precomputed, such that a board is mapped with one table lookup per byte.
+*/
+template <typename Board>
+struct BasicBoardSymmetry {
+	std::array<std::array<Board, 256>, kBitboardBits<Board> / 8> byteImages{};
+
+	Board apply(const Board& board) const {
+		Board image{};
+		for (std::size_t wordIdx = 0; wordIdx < kBitboardWords<Board>; ++wordIdx) {
+			uint64_t word = bitboardWord(board, wordIdx);
+			for (std::size_t byteIdx = 8 * wordIdx; word != 0; ++byteIdx, word >>= 8) {
+				image |= byteImages[byteIdx][word & 0xFF];
+			}
+		}
+		return image;
+	}
+};
+
+using BoardSymmetry = BasicBoardSymmetry<uint64_t>;
+
+
+/**
+	Describes the jump directions on the grid bitboard of a board layout.
+*/
+enum JumpDirection : std::size_t {
+	Right,
+	Left,
+	Down,
+	Up,
+};
+
+/**
+	Pagoda function of a board layout, i.e. a weighting of the fields such that for every jump
+	the weight of the target field is at most the sum of the weights of the start field and the field jumped over.
+	Thereby the pagoda value (sum of the weights of all pegs) never increases by a move and
+	every board whose value is below the value of the goal board cannot be solved.
+*/
+template <typename Board>
+struct BasicPagoda {
+	std::array<int, kBitboardBits<Board>> weights{}; // weight of every grid bit
+	int goalValue{ 0 }; // pagoda value of the goal board
+
+	int value(Board board) const {
+		int sum = 0;
+		for (; board != Board{}; board = withoutLowestBit(board)) {
+			sum += weights[lowestBitIndex(board)];
+		}
+		return sum;
+	}
+
+	/**
+		Gets the change of the pagoda value by a move (in grid bits), which is never positive.
+	*/
+	int delta(const MoveByte& move) const {
+		return weights[move.to] - weights[move.from] - weights[move.over];
+	}
+};
+
+using Pagoda = BasicPagoda<uint64_t>;
+
+template <typename Board>
+using BasicJumpSet = std::array<Board, 4>; // for each jump direction the bitmask of all pegs that can jump in this direction
+
+using JumpSet = BasicJumpSet<uint64_t>;
+
+
+/**
+	Describes a board layout for the solver.
+	Within the solver a board is represented as grid bitboard, i.e. the field at (row, col) is stored in bit row * cols + col.
+	Thereby every jump in one direction is the same shift for all fields and all legal jumps are generated with a few word operations.
+	Outside of the solver (GameLogic, UserInterface) the compact bit indices of the grid index maps are used instead.
+	\tparam GridBoard The bitboard type holding the grid of the board (see BitboardFor), the compact boards use the same type
+*/
+template <typename GridBoard>
+struct BasicBoardLayout {
+	using Board = GridBoard;
+	using Symmetry = BasicBoardSymmetry<Board>;
+	using Pagoda = BasicPagoda<Board>;
+	using JumpSet = BasicJumpSet<Board>;
+	static constexpr std::size_t kGridBits = kBitboardBits<Board>;
+
+	std::size_t cols{ 0 }; // width of the grid, i.e. the shift of a vertical step
+	std::array<uint8_t, kGridBits> gridToBitIdx{}; // maps grid bits to the compact bit indices of GameLogic
+	std::array<uint8_t, kGridBits> bitIdxToGrid{}; // maps the compact bit indices of GameLogic to grid bits
+	Board fields{}; // all fields of the board as grid bitboard
+	Board solutionBoard{}; // goal board as grid bitboard
+	std::array<Board, 4> jumpOrigins{}; // for each jump direction the fields from which such a jump stays on the board
+	std::vector<Symmetry> symmetries{}; // the symmetries of the layout keeping the goal field in place (identity excluded)
+	uint8_t symmetryGroup{ 1 }; // bit k is set if the k-th element of D4 is one of the symmetries (bit 0 is the identity)
+	std::vector<Pagoda> pagodas{}; // the pagoda functions used to prune the search
+	std::array<std::array<Board, 3>, 2> diagonalClasses{}; // fields with (row + col) % 3 == k resp. (row - col) % 3 == k
+
+	/**
+		Gets the layout of one of the built-in boards (only defined for 64 bit boards).
+		The layouts are built on first use and live until the end of the program.
+		\param type The built-in board
+		\return The layout of the built-in board
+	*/
+	static const BasicBoardLayout& forBoardType(BoardType type);
+
+	/**
+		Builds the layout of a board.
+		\param tables The tables derived from the initial grid of the board (see BoardTables.h)
+		\param pagodaWeights Additional pagoda functions of the board, given as weights of the compact bit indices
+		\return The layout with grid mapping, jump masks, symmetries and pagoda functions of the board
+	*/
+	static BasicBoardLayout build(const BasicBoardTables<Board>& tables, const std::vector<std::vector<int>>& pagodaWeights = {});
+
+	/**
+		Adds a pagoda function to the layout.
+		\param pagoda The weights of the pagoda function (the goal value is computed)
+		\throws std::invalid_argument If the weights do not form a pagoda function, i.e. if a jump could increase the value
+	*/
+	void addPagoda(Pagoda pagoda);
+
+	/**
+		Converts a board from the compact format of GameLogic into a grid bitboard.
+	*/
+	Board toGridBoard(Board board) const {
+		Board gridBoard{};
+		for (; board != Board{}; board = withoutLowestBit(board)) {
+			gridBoard |= singleBit<Board>(bitIdxToGrid[lowestBitIndex(board)]);
+		}
+		return gridBoard;
+	}
+
+	/**
+		Creates the move (in grid bits) of the peg at the given grid bit jumping in the given direction.
+	*/
+	MoveByte gridMove(unsigned int from, std::size_t direction) const {
+		return gridMove(from, direction, cols);
+	}
+
+	/**
+		Creates the move (in grid bits) of the peg at the given grid bit jumping in the given direction on a grid of the given width.
+		Solvers knowing the width at compile time use this overload, so the steps become constants.
+	*/
+	static constexpr MoveByte gridMove(unsigned int from, std::size_t direction, std::size_t cols) {
+		const std::size_t step = (direction == JumpDirection::Down || direction == JumpDirection::Up) ? cols : 1;
+		if (direction == JumpDirection::Right || direction == JumpDirection::Down) {
+			return MoveByte(static_cast<uint8_t>(from), static_cast<uint8_t>(from + step), static_cast<uint8_t>(from + 2 * step));
+		}
+		return MoveByte(static_cast<uint8_t>(from), static_cast<uint8_t>(from - step), static_cast<uint8_t>(from - 2 * step));
+	}
+
+	/**
+		Converts a move from grid bits into the compact bit indices of GameLogic.
+	*/
+	MoveByte toBitIdxMove(const MoveByte& move) const {
+		return MoveByte(gridToBitIdx[move.from], gridToBitIdx[move.over], gridToBitIdx[move.to]);
+	}
+
+	/**
+		Generates all legal jumps of a grid bitboard: a peg can jump if the neighboring field holds a peg and the field behind it is empty.
+		\param board The grid bitboard
+		\return For each jump direction the bitmask of the pegs which can jump
+	*/
+	JumpSet legalJumps(const Board& board) const {
+		return legalJumps(board, jumpOrigins, cols);
+	}
+
+	/**
+		Generates all legal jumps of a grid bitboard with the given jump masks and grid width.
+		Solvers knowing the layout at compile time use this overload, so the masks and shifts become constants.
+	*/
+	static constexpr JumpSet legalJumps(const Board& board, const std::array<Board, 4>& jumpOrigins, std::size_t cols) {
+		const Board holes = ~board; // jumpOrigins guarantees that the target field is part of the board
+		const std::size_t row = cols;
+		return { {
+			jumpOrigins[JumpDirection::Right] & board & (board >> 1) & (holes >> 2),
+			jumpOrigins[JumpDirection::Left] & board & (board << 1) & (holes << 2),
+			jumpOrigins[JumpDirection::Down] & board & (board >> row) & (holes >> (2 * row)),
+			jumpOrigins[JumpDirection::Up] & board & (board << row) & (holes << (2 * row)),
+		} };
+	}
+
+	/**
+		Generates all legal reverse jumps of a grid bitboard, i.e. the moves which lead to the board.
+		A jump from a to c over b is possible on a board iff its reverse (pegs at a and b, c emptied) is possible on the complement,
+		so the reverse jumps are the legal jumps of the complement. The bitmasks contain the origins of the forward jumps.
+		\param board The grid bitboard
+		\return For each jump direction the bitmask of the fields which receive a peg again
+	*/
+	JumpSet legalReverseJumps(const Board& board) const {
+		return legalJumps(fields & ~board);
+	}
+
+	/**
+		Gets the position class of a grid bitboard (Conway's resource count).
+		Three consecutive fields of a row or column lie on different diagonals modulo 3, so every jump flips the parity
+		of the peg count on each of the three diagonal classes. The parities of the pairwise sums are therefore invariant,
+		which gives an element of Z2 x Z2 per diagonal direction. A board can only be solved if its class equals the class of the goal.
+		\param board The grid bitboard
+		\return The position class encoded in 4 bits
+	*/
+	unsigned int positionClass(const Board& board) const {
+		unsigned int positionClass = 0;
+		for (const std::array<Board, 3>& classes : diagonalClasses) {
+			const unsigned int count0 = pegCount(board & classes[0]);
+			const unsigned int count1 = pegCount(board & classes[1]);
+			const unsigned int count2 = pegCount(board & classes[2]);
+			positionClass = (positionClass << 2) | (((count0 + count1) & 1) << 1) | ((count1 + count2) & 1);
+		}
+		return positionClass;
+	}
+
+	/**
+		Gets the canonical representative of a grid bitboard, i.e. the smallest bitmask among all of its symmetric images.
+	*/
+	Board canonicalize(const Board& board) const {
+		Board canonicalBoard = board;
+		for (const Symmetry& symmetry : symmetries) {
+			canonicalBoard = std::min(canonicalBoard, symmetry.apply(board));
+		}
+		return canonicalBoard;
+	}
+};
+
+using BoardLayout = BasicBoardLayout<uint64_t>; // layout of the boards of the game, whose grids fit into 64 bits
+
+template <>
+const BoardLayout& BoardLayout::forBoardType(BoardType type);
+
+// build() and addPagoda() are instantiated in BoardLayout.cpp for these bitboard types
+extern template struct BasicBoardLayout<uint64_t>;
+extern template struct BasicBoardLayout<Bitboard<2>>;
+extern template struct BasicBoardLayout<Bitboard<4>>;
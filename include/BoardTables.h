@@ -0,0 +1,328 @@
+#pragma once
+#include <array>
+#include <utility>
+#include <initializer_list>
+#include <stdexcept>
+#include <cstddef>
+#include <cstdint>
+#include "Move.h"
+#include "Bitboard.h"
+
+
+/**
+	Tables of a board derived from its initial grid, at compile time for the built-in grids below and at load time for board files
+	(see BoardDefinition.h). The fields are numbered row by row, which gives the compact bit indices of GameLogic (the order of GameLogic::m_board).
+	Within the solver the field at (row, col) is stored in the grid bit row * cols + col.
+	\tparam GridBoard The bitboard type holding the grid of the board (see BitboardFor)
+*/
+template <typename GridBoard>
+struct BasicBoardTables {
+	using Board = GridBoard;
+	static constexpr std::size_t kGridBits = kBitboardBits<Board>;
+	static constexpr std::size_t kMaxMoves = 4 * kGridBits; // four jump directions per field
+	static constexpr uint8_t kNoField = 0xFF;
+	static constexpr std::size_t kMaxMovesPerField = 12; // a field is origin, jumped over or target of at most four jumps each
+
+	std::size_t rows{ 0 };
+	std::size_t cols{ 0 };
+	std::size_t fieldCount{ 0 };
+	std::array<uint8_t, kGridBits> gridToBitIdx{}; // maps grid bits to compact bit indices (kNoField outside of the board)
+	std::array<uint8_t, kGridBits> bitIdxToGrid{}; // maps compact bit indices to grid bits
+	Board fields{}; // all fields as grid bitboard
+	Board startBoard{}; // initial board in compact format
+	Board solutionBoard{}; // goal board in compact format
+	Board gridSolutionBoard{}; // goal board as grid bitboard
+	std::array<Board, 4> jumpOrigins{}; // for each JumpDirection the grid bits from which such a jump stays on the board
+	std::size_t moveCount{ 0 };
+	std::array<MoveByte, kMaxMoves> moves{}; // all jumps of the board in compact bit indices, ordered by origin and direction
+	std::array<uint8_t, kGridBits> fieldMoveCounts{}; // number of jumps touching each compact bit index
+	std::array<std::array<uint16_t, kMaxMovesPerField>, kGridBits> fieldMoves{}; // indices of the jumps with the field as origin, jumped over or target
+	uint8_t symmetryGroup{ 1 }; // bit k is set if transform(k, ...) maps the fields and the goal onto themselves (bit 0 is the identity)
+
+	/**
+		Group of the forward jumps (right and down) whose field jumped over and target field lie at the same distances
+		from the origin in compact bit indices. As the fields of a row are numbered consecutively, there are only a few groups:
+		one for the horizontal jumps of every gapless row and one for the vertical jumps between each three rows.
+	*/
+	struct JumpShift {
+		Board origins{}; // compact bits of the origins of the jumps
+		uint8_t overShift{ 0 }; // distance of the field jumped over
+		uint8_t toShift{ 0 }; // distance of the target field
+	};
+	std::size_t jumpShiftCount{ 0 };
+	std::array<JumpShift, kMaxMoves / 2> jumpShifts{}; // at most two forward jumps per field
+
+	/**
+		Gets the 2D position of a compact bit index.
+	*/
+	constexpr std::pair<int, int> position(std::size_t bitIdx) const {
+		return { static_cast<int>(bitIdxToGrid[bitIdx] / cols), static_cast<int>(bitIdxToGrid[bitIdx] % cols) };
+	}
+
+	/**
+		Gets the compact bit index of a 2D position, or kNoField if the position is no field of the board.
+	*/
+	constexpr uint8_t bitIdx(int row, int col) const {
+		if (row < 0 || col < 0 || row >= static_cast<int>(rows) || col >= static_cast<int>(cols)) {
+			return kNoField;
+		}
+		return gridToBitIdx[static_cast<std::size_t>(row) * cols + static_cast<std::size_t>(col)];
+	}
+
+	/**
+		Applies the k-th element of the dihedral group D4, acting on the bounding box of the grid, to a 2D position.
+	*/
+	constexpr std::pair<int, int> transform(int symmetryIdx, std::pair<int, int> position) const {
+		const int maxRow = static_cast<int>(rows) - 1;
+		const int maxCol = static_cast<int>(cols) - 1;
+		const auto [row, col] = position;
+		switch (symmetryIdx) {
+		case 1: return { row, maxCol - col };            // mirror left <-> right
+		case 2: return { maxRow - row, col };            // mirror top <-> bottom
+		case 3: return { maxRow - row, maxCol - col };   // rotation by 180 degrees
+		case 4: return { col, row };                     // mirror along main diagonal
+		case 5: return { maxCol - col, maxRow - row };   // mirror along anti diagonal
+		case 6: return { col, maxRow - row };            // rotation by 90 degrees
+		case 7: return { maxCol - col, row };            // rotation by 270 degrees
+		default: return position;
+		}
+	}
+
+	/**
+		Checks whether any jump is legal on a board in compact format, with one shift and mask per jump group.
+		Every backward jump is the reverse of a forward jump, so a group covers both: the field jumped over holds a peg
+		and exactly one of origin and target holds a peg.
+	*/
+	constexpr bool hasLegalMove(const Board& board) const {
+		Board movable{};
+		for (std::size_t idx = 0; idx < jumpShiftCount; ++idx) {
+			const JumpShift& jumpShift = jumpShifts[idx];
+			movable |= jumpShift.origins & (board >> jumpShift.overShift) & (board ^ (board >> jumpShift.toShift));
+		}
+		return movable != Board{};
+	}
+
+	/**
+		Gets the number of symmetries of the board besides the identity.
+	*/
+	constexpr std::size_t symmetryCount() const {
+		std::size_t count = 0;
+		for (int symmetryIdx = 1; symmetryIdx < 8; ++symmetryIdx) {
+			count += (symmetryGroup >> symmetryIdx) & 1;
+		}
+		return count;
+	}
+};
+
+
+/**
+	Gets the position of the only empty field of an initial grid.
+*/
+template <std::size_t Rows, std::size_t Cols>
+constexpr std::pair<int, int> initialHole(const std::array<std::array<int, Cols>, Rows>& grid) {
+	for (std::size_t row = 0; row < Rows; ++row) {
+		for (std::size_t col = 0; col < Cols; ++col) {
+			if (grid[row][col] == 0) {
+				return { static_cast<int>(row), static_cast<int>(col) };
+			}
+		}
+	}
+	throw std::invalid_argument("The initial board has no empty field.");
+}
+
+/**
+	Adds the origin of a forward jump to the jump group of its distances, which is created if the distances are new.
+*/
+template <typename Tables>
+constexpr void addJumpShift(Tables& tables, std::size_t from, uint8_t overShift, uint8_t toShift) {
+	std::size_t idx = 0;
+	while (idx < tables.jumpShiftCount && (tables.jumpShifts[idx].overShift != overShift || tables.jumpShifts[idx].toShift != toShift)) {
+		++idx;
+	}
+	if (idx == tables.jumpShiftCount) {
+		tables.jumpShifts[tables.jumpShiftCount++] = { {}, overShift, toShift };
+	}
+	tables.jumpShifts[idx].origins |= singleBit<typename Tables::Board>(from);
+}
+
+/**
+	Derives the tables of a board from its grid, at compile time for the built-in boards and at load time for boards read from a file.
+	\param rows The height of the grid
+	\param cols The width of the grid
+	\param cell Callable giving the initial state of a cell of the grid, cell(row, col) (-1: no field, 0: empty field, 1: peg)
+	\param isGoal Callable telling whether a cell holds a peg in the goal board, isGoal(row, col) (usually a single field)
+	\return The tables of the board
+	\throws std::invalid_argument If the grid does not fit into the bitboard type or the goal board has no peg or a peg outside of the board
+*/
+template <typename Board, typename Cell, typename IsGoal>
+constexpr BasicBoardTables<Board> buildBoardTables(std::size_t rows, std::size_t cols, Cell&& cell, IsGoal&& isGoal) {
+	using Tables = BasicBoardTables<Board>;
+	if (rows * cols > Tables::kGridBits || rows * cols >= Tables::kNoField) {
+		throw std::invalid_argument("The grid of the board does not fit into its bitboard type.");
+	}
+	Tables tables;
+	tables.rows = rows;
+	tables.cols = cols;
+	for (std::size_t gridBit = 0; gridBit < Tables::kGridBits; ++gridBit) {
+		tables.gridToBitIdx[gridBit] = Tables::kNoField;
+	}
+	for (std::size_t row = 0; row < rows; ++row) {
+		for (std::size_t col = 0; col < cols; ++col) {
+			const int state = cell(row, col);
+			if (state < 0) {
+				continue;
+			}
+			const std::size_t gridBit = row * cols + col;
+			tables.gridToBitIdx[gridBit] = static_cast<uint8_t>(tables.fieldCount);
+			tables.bitIdxToGrid[tables.fieldCount] = static_cast<uint8_t>(gridBit);
+			tables.fields |= singleBit<Board>(gridBit);
+			if (state == 1) {
+				tables.startBoard |= singleBit<Board>(tables.fieldCount);
+			}
+			if (isGoal(row, col)) {
+				tables.solutionBoard |= singleBit<Board>(tables.fieldCount);
+				tables.gridSolutionBoard |= singleBit<Board>(gridBit);
+			}
+			++tables.fieldCount;
+		}
+	}
+	for (std::size_t row = 0; row < rows; ++row) {
+		for (std::size_t col = 0; col < cols; ++col) {
+			if (cell(row, col) < 0 && isGoal(row, col)) {
+				throw std::invalid_argument("The goal is no field of the board.");
+			}
+		}
+	}
+	if (tables.solutionBoard == Board{}) {
+		throw std::invalid_argument("The goal board has no peg.");
+	}
+
+	// A peg can jump in a direction if the field jumped over and the target field are part of the board (see JumpDirection)
+	constexpr std::array<std::pair<int, int>, 4> steps{ { { 0, 1 }, { 0, -1 }, { 1, 0 }, { -1, 0 } } };
+	for (std::size_t from = 0; from < tables.fieldCount; ++from) {
+		const auto [row, col] = tables.position(from);
+		for (std::size_t direction = 0; direction < steps.size(); ++direction) {
+			const uint8_t over = tables.bitIdx(row + steps[direction].first, col + steps[direction].second);
+			const uint8_t to = tables.bitIdx(row + 2 * steps[direction].first, col + 2 * steps[direction].second);
+			if (over != Tables::kNoField && to != Tables::kNoField) {
+				tables.jumpOrigins[direction] |= singleBit<Board>(tables.bitIdxToGrid[from]);
+				tables.moves[tables.moveCount++] = MoveByte(static_cast<uint8_t>(from), over, to);
+				if (to > from) {
+					addJumpShift(tables, from, static_cast<uint8_t>(over - from), static_cast<uint8_t>(to - from));
+				}
+			}
+		}
+	}
+	// A jump can only change its legality if one of its three fields changes
+	for (std::size_t moveIdx = 0; moveIdx < tables.moveCount; ++moveIdx) {
+		for (const uint8_t field : { tables.moves[moveIdx].from, tables.moves[moveIdx].over, tables.moves[moveIdx].to }) {
+			tables.fieldMoves[field][tables.fieldMoveCounts[field]++] = static_cast<uint16_t>(moveIdx);
+		}
+	}
+
+	// Only symmetries keeping the goal board in place can be used for the transposition table: a board is unsolvable iff
+	// its image is unsolvable, as long as the image has to reach the same goal board
+	for (int symmetryIdx = 1; symmetryIdx < 8; ++symmetryIdx) {
+		bool isSymmetry = true;
+		for (std::size_t idx = 0; idx < tables.fieldCount && isSymmetry; ++idx) {
+			const auto [row, col] = tables.transform(symmetryIdx, tables.position(idx));
+			const bool isGoalField = (tables.solutionBoard & singleBit<Board>(idx)) != Board{};
+			isSymmetry = tables.bitIdx(row, col) != Tables::kNoField
+				&& ((tables.solutionBoard & singleBit<Board>(tables.bitIdx(row, col))) != Board{}) == isGoalField;
+		}
+		if (isSymmetry) {
+			tables.symmetryGroup |= static_cast<uint8_t>(1U << symmetryIdx);
+		}
+	}
+	return tables;
+}
+
+/**
+	Derives the tables of a built-in board from its initial grid at compile time.
+	\param grid The initial grid (-1: no field, 0: empty field, 1: peg)
+	\param goal The field of the last peg of a solution
+	\return The tables of the board
+*/
+template <std::size_t Rows, std::size_t Cols>
+constexpr BasicBoardTables<BitboardFor<Rows * Cols>> makeBoardTables(const std::array<std::array<int, Cols>, Rows>& grid, std::pair<int, int> goal) {
+	static_assert(Rows * Cols < 0xFF, "The grid bits of the board have to fit into the bytes of a MoveByte (0xFF marks no field).");
+	return buildBoardTables<BitboardFor<Rows * Cols>>(Rows, Cols,
+		[&grid](std::size_t row, std::size_t col) { return grid[row][col]; },
+		[goal](std::size_t row, std::size_t col) { return static_cast<int>(row) == goal.first && static_cast<int>(col) == goal.second; });
+}
+
+
+using BoardTables = BasicBoardTables<uint64_t>; // tables of the boards of the game, whose grids fit into 64 bits
+
+
+/**
+	The boards built into the solver, whose tables are derived at compile time, such that the solver is specialized on them (see BoardTraits.h).
+	The game plays the same boards from their files in assets/boards, these built-in copies serve as reference for the loaded boards.
+*/
+enum class BoardType {
+	English,		// Standard English Peg Solitaire board
+	European,		// European variant of the Peg Solitaire board
+	Asymmetric,		// Diamond-shaped Peg Solitaire board
+	SmallDiamond,	// Small Diamond-shaped Peg Solitaire board
+};
+
+// The initial grids of the built-in boards (-1: no field, 0: empty field, 1: peg)
+inline constexpr std::array<std::array<int, 7>, 7> englishBoard{ {
+	{-1, -1,  1,  1,  1, -1, -1},
+	{-1, -1,  1,  1,  1, -1, -1},
+	{ 1,  1,  1,  1,  1,  1,  1},
+	{ 1,  1,  1,  0,  1,  1,  1},
+	{ 1,  1,  1,  1,  1,  1,  1},
+	{-1, -1,  1,  1,  1, -1, -1},
+	{-1, -1,  1,  1,  1, -1, -1},
+} };
+inline constexpr std::array<std::array<int, 7>, 7> europeanBoard{ {
+	{-1, -1,  0,  1,  1, -1, -1},
+	{-1,  1,  1,  1,  1,  1, -1},
+	{ 1,  1,  1,  1,  1,  1,  1},
+	{ 1,  1,  1,  1,  1,  1,  1},
+	{ 1,  1,  1,  1,  1,  1,  1},
+	{-1,  1,  1,  1,  1,  1, -1},
+	{-1, -1,  1,  1,  1, -1, -1},
+} };
+inline constexpr std::array<std::array<int, 8>, 8> asymmetricBoard{ {
+	{-1, -1,  1,  1,  1, -1, -1, -1},
+	{-1, -1,  1,  1,  1, -1, -1, -1},
+	{-1, -1,  1,  1,  1, -1, -1, -1},
+	{ 1,  1,  1,  1,  1,  1,  1,  1},
+	{ 1,  1,  1,  0,  1,  1,  1,  1},
+	{ 1,  1,  1,  1,  1,  1,  1,  1},
+	{-1, -1,  1,  1,  1, -1, -1, -1},
+	{-1, -1,  1,  1,  1, -1, -1, -1},
+} };
+inline constexpr std::array<std::array<int, 7>, 8> smallDiamondBoard{ {
+	{-1, -1, -1,  1, -1, -1, -1},
+	{-1, -1,  1,  1,  1, -1, -1},
+	{-1,  1,  1,  1,  1,  1, -1},
+	{ 1,  1,  1,  0,  1,  1,  1},
+	{ 1,  1,  1,  1,  1,  1,  1},
+	{-1,  1,  1,  1,  1,  1, -1},
+	{-1, -1,  1,  1,  1, -1, -1},
+	{-1, -1, -1,  1, -1, -1, -1},
+} };
+
+inline constexpr BoardTables englishBoardTables = makeBoardTables(englishBoard, initialHole(englishBoard));
+// The European board starts with the hole at a corner field and is solved at the opposite corner field
+inline constexpr BoardTables europeanBoardTables = makeBoardTables(europeanBoard, { 6, 4 });
+inline constexpr BoardTables asymmetricBoardTables = makeBoardTables(asymmetricBoard, initialHole(asymmetricBoard));
+inline constexpr BoardTables smallDiamondBoardTables = makeBoardTables(smallDiamondBoard, initialHole(smallDiamondBoard));
+
+// Wiegleb's board is no built-in board, its grid of 81 bits runs the solver on 128 bit boards (see WieglebBoardTraits)
+inline constexpr std::array<std::array<int, 9>, 9> wieglebBoard{ {
+	{-1, -1, -1,  1,  1,  1, -1, -1, -1},
+	{-1, -1, -1,  1,  1,  1, -1, -1, -1},
+	{-1, -1, -1,  1,  1,  1, -1, -1, -1},
+	{ 1,  1,  1,  1,  1,  1,  1,  1,  1},
+	{ 1,  1,  1,  1,  0,  1,  1,  1,  1},
+	{ 1,  1,  1,  1,  1,  1,  1,  1,  1},
+	{-1, -1, -1,  1,  1,  1, -1, -1, -1},
+	{-1, -1, -1,  1,  1,  1, -1, -1, -1},
+	{-1, -1, -1,  1,  1,  1, -1, -1, -1},
+} };
+inline constexpr BasicBoardTables<Bitboard<2>> wieglebBoardTables = makeBoardTables(wieglebBoard, initialHole(wieglebBoard));
+
@@ -0,0 +1,109 @@
+#pragma once
+#include <algorithm>
+#include <type_traits>
+#include <cstddef>
+#include "BoardLayout.h"
+#include "BoardTables.h"
+#include "MoveOrdering.h"
+
+
+/*
+	Board traits describe a board to the solver at compile time, the solver of a board is Solver<Traits> (see Solver.cpp):
+	- kTables: the tables of the board, i.e. its fields, move table, goal board and symmetry group (see BoardTables.h)
+	- kDefaultSearchStrategy: the strategy the solver starts with
+	- layout(): the layout with the data of the board built at runtime, i.e. the images of its symmetries and its pagoda functions
+	The game plays boards loaded from board files, which need no code at all (see LoadedBoardTraits and BoardDefinition.h).
+	The traits of the built-in boards specialize the solver on one board at compile time, e.g. to compare it with the loaded boards.
+*/
+
+struct EnglishBoardTraits {
+	static constexpr const auto& kTables = englishBoardTables;
+	static constexpr SearchStrategy kDefaultSearchStrategy = SearchStrategy::OrderedDepthFirst;
+
+	static const BoardLayout& layout() {
+		return BoardLayout::forBoardType(BoardType::English);
+	}
+};
+
+
+struct EuropeanBoardTraits {
+	static constexpr const auto& kTables = europeanBoardTables;
+	static constexpr SearchStrategy kDefaultSearchStrategy = SearchStrategy::Beam;
+
+	static const BoardLayout& layout() {
+		return BoardLayout::forBoardType(BoardType::European);
+	}
+};
+
+
+struct AsymmetricBoardTraits {
+	static constexpr const auto& kTables = asymmetricBoardTables;
+	static constexpr SearchStrategy kDefaultSearchStrategy = SearchStrategy::Beam;
+
+	static const BoardLayout& layout() {
+		return BoardLayout::forBoardType(BoardType::Asymmetric);
+	}
+};
+
+
+struct SmallDiamondBoardTraits {
+	static constexpr const auto& kTables = smallDiamondBoardTables;
+	static constexpr SearchStrategy kDefaultSearchStrategy = SearchStrategy::OrderedDepthFirst;
+
+	static const BoardLayout& layout() {
+		return BoardLayout::forBoardType(BoardType::SmallDiamond);
+	}
+};
+
+
+/**
+	Wiegleb's board, which the game cannot play. Its grid needs more than 64 bits, so it is solved on 128 bit boards.
+	These traits are used by --compare-strategies, --solve-board loads the same board from assets/boards/wiegleb.board (see LoadedBoardTraits).
+	The plain depth-first search does not solve boards of this size: on the start board it fills the default transposition table
+	and still runs after a minute, while the ordered depth-first search solves it in less than 0.1 s.
+*/
+struct WieglebBoardTraits {
+	static constexpr const auto& kTables = wieglebBoardTables;
+	static constexpr SearchStrategy kDefaultSearchStrategy = SearchStrategy::OrderedDepthFirst;
+
+	static const BasicBoardLayout<Bitboard<2>>& layout() {
+		static const BasicBoardLayout<Bitboard<2>> layout = BasicBoardLayout<Bitboard<2>>::build(kTables);
+		return layout;
+	}
+};
+
+
+/**
+	Traits of a board loaded from a file (see BoardDefinition.h). Its tables are only known at runtime, so the solver
+	is created with the layout of the loaded board and reads the goal, jump masks and symmetries from there.
+	A loaded board may be as large as Wiegleb's board, so its solver has to stay on SearchStrategy::OrderedDepthFirst:
+	the plain depth-first search runs out of the transposition table on such boards (see WieglebBoardTraits).
+	\tparam GridBoard The bitboard type holding the grid of the board
+*/
+template <typename GridBoard>
+struct LoadedBoardTraits {
+	using Board = GridBoard;
+	static constexpr SearchStrategy kDefaultSearchStrategy = SearchStrategy::OrderedDepthFirst;
+};
+
+
+/**
+	The compile time bounds of the solver of a board: the bitboard type, the depth of the search and the moves per board.
+	Boards loaded from a file are bounded by the capacity of their bitboard type.
+*/
+template <typename BoardTraits>
+struct BoardTraitsBounds {
+	using Board = typename std::decay_t<decltype(BoardTraits::kTables)>::Board;
+	static constexpr bool kIsLoaded = false;
+	static constexpr std::size_t kMaxDepth = BoardTraits::kTables.fieldCount;
+	static constexpr std::size_t kMaxMoves = BoardTraits::kTables.moveCount;
+};
+
+template <typename GridBoard>
+struct BoardTraitsBounds<LoadedBoardTraits<GridBoard>> {
+	using Board = GridBoard;
+	static constexpr bool kIsLoaded = true;
+	static constexpr std::size_t kMaxDepth = std::min<std::size_t>(BasicBoardTables<Board>::kGridBits, BasicBoardTables<Board>::kNoField);
+	static constexpr std::size_t kMaxMoves = BasicBoardTables<Board>::kMaxMoves;
+};
+
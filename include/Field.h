@@ -1,5 +1,6 @@
 #pragma once
 #include <utility>
+#include <cstdint>
 
 /**
 	Describes the state of a field in the Peg Solitaire game.
@@ -15,37 +16,47 @@ enum class FieldState {
 
 /**
 	Represents a field in the Peg Solitaire game.
+	The field is a view onto one bit of the bitboards held by GameLogic, i.e. it stores no state of its own.
+	Its views are valid as long as the GameLogic owning the bitboards exists and the board is not reset to another board.
 */
 class Field {
 private:
-	FieldState m_state{}; // describes the state of the field
-	std::pair<int, int> m_position{}; // position of the field within the game board when represented as a 7x7 grid
+	uint64_t* m_pegs{ nullptr }; // bitboard of the pegs (compact format of the solver), which the field is a bit of
+	uint64_t* m_selectedPegs{ nullptr }; // bitboard of the selected pegs
+	uint8_t m_bitIdx{ 0 }; // compact bit index of the field, i.e. its bit within the bitboards
+	std::pair<int, int> m_position{}; // position of the field within the game board when represented as a 2D grid
 
 public:
-	Field() = default;
-	Field(FieldState state, std::pair<int, int> position);
+	/**
+		Creates the view of a field.
+		\param pegs The bitboard of the pegs
+		\param selectedPegs The bitboard of the selected pegs
+		\param bitIdx The compact bit index of the field
+		\param position The position of the field as a pair of integers (row, column)
+	*/
+	Field(uint64_t& pegs, uint64_t& selectedPegs, uint8_t bitIdx, std::pair<int, int> position);
 
 	/**
 		Gets the state of the field, i.e. whether it is empty, occupied, or selected.
 		\return The current state of the field
 	*/
-	const FieldState& getState() const;
+	FieldState getState() const;
 
 	/**
-		Gets the position of the field within the game board when represented as a 7x7 grid.
+		Gets the position of the field within the game board when represented as a 2D grid.
 		\return The position of the field as a pair of integers (row, column)
 	*/
 	std::pair<int, int> getPosition() const;
 
 	/**
-		Sets the state of the field.
-		\param state The new state to set for the field
+		Gets the compact bit index of the field, i.e. its bit within the board of GameLogic and the solver.
+		\return The compact bit index of the field
 	*/
-	void setState(const FieldState& state);
+	uint8_t getBitIdx() const;
 
 	/**
-		Sets the position of the field wihin the game board when represented as a 7x7 grid.
-		\param position The new position to set for the field as a pair of integers (row, column)
+		Sets the state of the field by updating its bits within the bitboards.
+		\param state The new state to set for the field
 	*/
-	void setPosition(const std::pair<int, int>& position);
+	void setState(const FieldState& state);
 };
\ No newline at end of file
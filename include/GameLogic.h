@@ -1,12 +1,18 @@
 #pragma once
 #include <vector>
-#include <map>
 #include <array>
 #include <utility>
+#include <cstdint>
 #include "Field.h"
 #include <stack>
 #include "Move.h"
 
+template <typename GridBoard>
+struct BasicBoardTables;
+
+template <typename GridBoard>
+struct BasicLoadedBoard;
+
 /**
 	Describes the possible states of the game.
 	- Playing: The game is ongoing and the player can make moves.
@@ -19,76 +25,46 @@ enum class GameState {
 	GameLost,
 };
 
-enum class BoardType {
-	English,		// Standard English Peg Solitaire board
-	European,		// European variant of the Peg Solitaire board
-	Asymmetric,		// Diamond-shaped Peg Solitaire board
-	SmallDiamond,	// Small Diamond-shaped Peg Solitaire board
-};
-
 /**
 	Implementation of the game logic for the Peg Solitaire game.
 */
 class GameLogic {
 private:
-	BoardType m_boardType{BoardType::English};
-	std::vector<Field> m_board{}; // Represents the board (33 fields in total in english, 37 in european, 32 in diamond, 39 in asymmetric) with 7x7-grid positions
-	std::stack<MovePair> m_moveHistory{}; // Stack to keep track of moves made during the game for undo functionality
+	const BasicLoadedBoard<uint64_t>* m_loadedBoard; // The board being played as loaded from its board file (see BoardDefinition.h)
+	const BasicBoardTables<uint64_t>* m_tables{ nullptr }; // Tables of the board being played (set at resetGame), whose dense grid index maps positions to fields
+	uint64_t m_pegs{ 0 }; // The authoritative board state as bitboard in the compact format of the solver (bit i: peg on the i-th field in row-major order)
+	uint64_t m_selectedPegs{ 0 }; // Bitboard of the peg selected for the next move (at most one bit)
+	std::vector<Field> m_board{}; // Views onto the bits of the fields (33 fields in total in english, 37 in european, 32 in diamond, 39 in asymmetric) with their grid positions
+	std::stack<MoveByte> m_moveHistory{}; // Stack to keep track of moves (in compact bit indices) made during the game for undo functionality
 	GameState m_gameState{ GameState::Playing }; // Current state of the game
 
-	static constexpr std::array<std::array<int, 7>, 7> defaultBoardEnglish{ {
-	{-1, -1,  1,  1,  1, -1, -1},
-	{-1, -1,  1,  1,  1, -1, -1},
-	{ 1,  1,  1,  1,  1,  1,  1},
-	{ 1,  1,  1,  0,  1,  1,  1},
-	{ 1,  1,  1,  1,  1,  1,  1},
-	{-1, -1,  1,  1,  1, -1, -1},
-	{-1, -1,  1,  1,  1, -1, -1},
-	} }; // Describes the initial state of the board when represented as a 7x7 grid
-	static constexpr std::array<std::array<int, 7>, 7> defaultBoardEuropean{ {
-	{-1, -1,  0,  1,  1, -1, -1},
-	{-1,  1,  1,  1,  1,  1, -1},
-	{ 1,  1,  1,  1,  1,  1,  1},
-	{ 1,  1,  1,  1,  1,  1,  1},
-	{ 1,  1,  1,  1,  1,  1,  1},
-	{-1,  1,  1,  1,  1,  1, -1},
-	{-1, -1,  1,  1,  1, -1, -1},
-	} };
-	static constexpr std::array<std::array<int, 8>, 8> defaultBoardAsymmetric{ {
-	{-1, -1,  1,  1,  1, -1, -1, -1},
-	{-1, -1,  1,  1,  1, -1, -1, -1},
-	{-1, -1,  1,  1,  1, -1, -1, -1},
-	{ 1,  1,  1,  1,  1,  1,  1,  1},
-	{ 1,  1,  1,  0,  1,  1,  1,  1},
-	{ 1,  1,  1,  1,  1,  1,  1,  1},
-	{-1, -1,  1,  1,  1, -1, -1, -1},
-	{-1, -1,  1,  1,  1, -1, -1, -1},
-	} };
-	static constexpr std::array<std::array<int, 7>, 8> defaultBoardSmallDiamond{ {
-	{-1, -1, -1,  1, -1, -1, -1},
-	{-1, -1,  1,  1,  1, -1, -1},
-	{-1,  1,  1,  1,  1,  1, -1},
-	{ 1,  1,  1,  0,  1,  1,  1},
-	{ 1,  1,  1,  1,  1,  1,  1},
-	{-1,  1,  1,  1,  1,  1, -1},
-	{-1, -1,  1,  1,  1, -1, -1},
-	{-1, -1, -1,  1, -1, -1, -1},
-	} };
+	// Cache of the legal jumps, which is brought up to date with the jumps touching the changed fields only
+	mutable uint64_t m_legalMovesBoard{ 0 }; // The bitboard the cache describes
+	mutable std::array<uint64_t, 4> m_legalMoves{}; // Bit k is set if the k-th jump of the board tables is legal
+	mutable std::array<uint8_t, 64> m_legalJumpCounts{}; // Number of legal jumps starting at each field
+	mutable uint64_t m_playablePegs{ 0 }; // Bitboard of the pegs with at least one legal jump
+	mutable std::size_t m_legalMoveCount{ 0 }; // Number of legal jumps
 
-public:
-	static const std::map<std::pair<int, int>, uint8_t> englishGridIdxMap;
-	static const std::map<std::pair<int, int>, uint8_t> europeanGridIdxMap;
-	static const std::map<std::pair<int, int>, uint8_t> asymmetricGridIdxMap;
-	static const std::map<std::pair<int, int>, uint8_t> smallDiamondGridIdxMap;
+	/**
+		Brings the cache of the legal jumps up to date with the current board. Only the jumps touching a field
+		that changed since the last update are checked again, which after a move are at most 36 jumps.
+	*/
+	void updateLegalMoves() const;
 
+public:
 	/**
-		Constructor for the GameLogic class, where the board is initialized with the default board state.
+		Constructor for the GameLogic class, where the board is initialized with the start board of a loaded board.
+		\param loadedBoard The board to play, which has to outlive the game logic
 	*/
-	GameLogic();
+	explicit GameLogic(const BasicLoadedBoard<uint64_t>& loadedBoard);
+
+	// The fields are views onto the bitboards of this instance, so it cannot be copied
+	GameLogic(const GameLogic&) = delete;
+	GameLogic& operator=(const GameLogic&) = delete;
 
 	/**
 		Gets the current state of the board.
-		\return A reference to the array representing the board as fields
+		\return A reference to the array representing the board as fields, which are views onto the bitboard of the game
 	*/
 	std::vector<Field>& getBoard();
 
@@ -96,7 +72,7 @@ public:
 		Gets the current move history of the game.
 		\return A reference to the stack containing the moves made during the game
 	*/
-	std::stack<MovePair>& getMoveHistory();
+	std::stack<MoveByte>& getMoveHistory();
 
 	/**
 		Gets the current state of the game.
@@ -111,41 +87,27 @@ public:
 	void setGameState(GameState state);
 
 	/**
-		Gets the current board type.
-		\return The current board type (English, European, Asymmetric, SmallDiamond)
-	*/
-	BoardType& getBoardType();
-
-	/**
-		Sets the board type for the game.
-		\param type The new board type to set
+		Gets the board being played.
+		\return The board as loaded from its board file
 	*/
-	void setBoardType(BoardType type);
+	const BasicLoadedBoard<uint64_t>& getLoadedBoard() const;
 
 	/**
-		Initializes the board based on the english variant of peg solitaire.
+		Sets the board for the game, which is played from the next reset on.
+		\param loadedBoard The new board to play, which has to outlive the game logic
 	*/
-	void initializeEnglishBoard();
+	void setLoadedBoard(const BasicLoadedBoard<uint64_t>& loadedBoard);
 
 	/**
-		Initializes the board based on the european variant of peg solitaire.
+		Initializes the board being played from its tables, i.e. the start bitboard and a view for every field.
 	*/
-	void initializeEuropeanBoard();
+	void initializeBoard();
 
 	/**
-		Initializes the board based on the small diamond variant of peg solitaire.
-	*/
-	void initializeSmallDiamondBoard();
-
-	/**
-		Initializes the board based on the asymmetric variant of peg solitaire.
-	*/
-	void initializeAsymmetricBoard();
-
-	/**
-		Gets the field at a specific position on the board.
+		Gets the field at a specific position on the board with a single lookup in the grid index of the board.
 		\param position The position of the field on the board as a pair of integers (row, column)
 		\return A reference to the field at the specified position
+		\throws std::runtime_error If there is no field at the position
 	*/
 	Field& getField(std::pair<int, int> position);
 
@@ -170,22 +132,36 @@ public:
 	void undoMove();
 
 	/**
-		Checks if there are any available moves left on the board.
+		Checks if there are any available moves left on the board, answered with a few shifts and masks of the bitboard.
 		\return True if there are moves available, false otherwise
 	*/
-	bool movesAvailable();
+	bool movesAvailable() const;
+
+	/**
+		Gets the pegs which can jump, e.g. to highlight them. The legal jumps are maintained with every move,
+		so this is a lookup that can be done every frame.
+		\return The bitboard of the pegs (in compact bit indices) with at least one legal jump
+	*/
+	uint64_t getPlayablePegs() const;
+
+	/**
+		Checks if the peg on a field can jump.
+		\param field The field to check
+		\return True if the field holds a peg with at least one legal jump, false otherwise
+	*/
+	bool isPlayable(const Field& field) const;
 
 	/**
-		Checks if the game is solved, meaning the only peg left on the board is the one in the center position.
+		Checks if the game is solved, meaning the only peg left on the board is the one on the goal field.
 		\return True if the game is solved, false otherwise
 	*/
-	bool solutionFound();
+	bool solutionFound() const;
 
 	/**
-		Converts the current board state into a format suitable for the PegSolitaireSolver.
-		\return A 7x7 array representing the board, where -1 indicates an invalid field, 0 indicates an empty field and 1 indicates a n occued field
+		Gets the current board state in the format of the solver, which is the bitboard the game is played on (no conversion needed).
+		\return The bitboard of the pegs, where bit i is set if the i-th field (in row-major order) holds a peg (selected or not)
 	*/
-	uint64_t convertBoardToSolverBoardFormat();
+	uint64_t getSolverBoard() const;
 
 	/**
 		Resets the game to its initial state, restoring the default board configuration.
@@ -0,0 +1,165 @@
+#pragma once
+#include <condition_variable>
+#include <functional>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include <future>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <cstddef>
+#include <cstdint>
+#include "GameLogic.h"
+#include "BoardDefinition.h"
+#include "Move.h"
+#include "SolvabilityTable.h"
+#include "SolverStats.h"
+#include "SearchBudget.h"
+
+
+/**
+	Outcome of a hint request.
+*/
+struct HintResult {
+	/**
+		Describes how the hint request ended.
+		- Found: move holds the next move of a solution
+		- NoSolution: the board cannot be solved anymore
+		- AlreadySolved: the board is the goal, no hint is needed
+		- TimedOut: the solver gave up before finding a solution
+		- Cancelled: the request was replaced or cancelled before it finished
+	*/
+	enum class Status {
+		Found,
+		NoSolution,
+		AlreadySolved,
+		TimedOut,
+		Cancelled,
+	};
+
+	Status status{ Status::Cancelled };
+	const LoadedBoard* loadedBoard{ nullptr }; // board the hint was computed for
+	uint64_t board{ 0 }; // board (in the compact format of GameLogic) the hint was computed for
+	MoveByte move{ 0, 0, 0 }; // next move of a solution in compact bit indices, only valid if a solution was found
+	SolverStats stats{}; // counters of the solver, all zero if a solvability table or the cache answered the request
+};
+
+
+/**
+	Computes hints on a background thread, so the game loop keeps rendering and handling input while the solver runs.
+	Only one hint is computed at a time: a new request or a call of cancel() cancels the hint that is still running.
+	A precomputed solvability table of the board answers a request right away, otherwise the parallel solver searches it.
+	After every change of the board, presolve() starts a speculative search of the new board on a single core, whose solution
+	is cached, so the hint requested afterwards is answered from the cache without any search.
+	Every board along a solution path found is cached with its next move, so a player following the hints gets each further
+	hint by a single lookup. A player leaving the path starts a new search, which still skips the boards proven dead before,
+	as they stay in the transposition table shared by all searches of the board.
+*/
+class HintEngine {
+private:
+	/**
+		A hint request waiting for the background thread.
+	*/
+	struct HintRequest {
+		const LoadedBoard* loadedBoard;
+		uint64_t board;
+		bool isSpeculative; // started by presolve(), nobody waits for its result
+		std::promise<HintResult> promise;
+	};
+
+	/**
+		Result of a completed search for one board, kept to answer later requests of the board.
+	*/
+	struct CachedHint {
+		HintResult::Status status; // Found or NoSolution
+		MoveByte move; // next move of the solution in compact bit indices, only valid if a solution was found
+	};
+
+	using CacheKey = std::pair<const LoadedBoard*, uint64_t>;
+
+	struct CacheKeyHash {
+		std::size_t operator()(const CacheKey& key) const {
+			return std::hash<uint64_t>{}(key.second * 0x9E3779B97F4A7C15ULL + static_cast<uint64_t>(reinterpret_cast<std::uintptr_t>(key.first)));
+		}
+	};
+
+	static constexpr std::size_t kMaxCachedHints = 1 << 16; // the cache is cleared when it grows beyond this
+
+	const SolvabilityTables& m_solvabilityTables;
+	std::mutex m_mutex; // guards all of the following members
+	std::condition_variable m_requestAvailable;
+	std::optional<HintRequest> m_pendingRequest{}; // request not yet taken by the background thread
+	CancelToken m_cancelToken{}; // cancels the running request, reset when the next request is taken
+	std::unordered_map<CacheKey, CachedHint, CacheKeyHash> m_cachedHints{}; // results of completed searches per board
+	bool m_isShutdown{ false };
+	std::thread m_thread; // declared last, so it starts after all other members are initialized
+
+	/**
+		Loop of the background thread: waits for requests and computes them one after another.
+	*/
+	void run();
+
+	/**
+		Computes the hint of one request on the background thread.
+		\param threadCount The number of threads of the solver (0 uses all hardware threads)
+	*/
+	HintResult computeHint(const LoadedBoard& loadedBoard, uint64_t board, unsigned int threadCount);
+
+	/**
+		Queues a request, cancelling the pending and the running one.
+	*/
+	std::future<HintResult> enqueue(const LoadedBoard& loadedBoard, uint64_t board, bool isSpeculative);
+
+	/**
+		Caches the result of a search for the searched board and every board along the solution path, m_mutex has to be locked.
+		\param solutionPath The moves of the solution in compact bit indices, empty if there is no solution
+	*/
+	void cacheSolution(const LoadedBoard& loadedBoard, uint64_t board, HintResult::Status status, const std::vector<MoveByte>& solutionPath);
+
+	/**
+		Gets the hint of a board from the cache, m_mutex has to be locked.
+	*/
+	std::optional<HintResult> cachedHint(const LoadedBoard& loadedBoard, uint64_t board) const;
+
+	/**
+		Cancels the pending and the running request, m_mutex has to be locked.
+	*/
+	void cancelLocked();
+
+public:
+	/**
+		Creates the hint engine and starts its background thread.
+		\param solvabilityTables The precomputed tables, which have to outlive the engine (as do the boards of the requests)
+	*/
+	explicit HintEngine(const SolvabilityTables& solvabilityTables);
+
+	/**
+		Cancels the running request and stops the background thread.
+	*/
+	~HintEngine();
+
+	HintEngine(const HintEngine&) = delete;
+	HintEngine& operator=(const HintEngine&) = delete;
+
+	/**
+		Requests a hint for a board, cancelling the request still running. A cached hint is returned right away.
+		\param loadedBoard The board being played
+		\param board The board in the compact format of GameLogic
+		\return The future receiving the result, which is never left without a value
+	*/
+	std::future<HintResult> request(const LoadedBoard& loadedBoard, uint64_t board);
+
+	/**
+		Starts a speculative search of a board which just appeared, cancelling the request still running.
+		It runs on a single core and does nothing if the board is cached or answered by a solvability table.
+		\param loadedBoard The board being played
+		\param board The board in the compact format of GameLogic
+	*/
+	void presolve(const LoadedBoard& loadedBoard, uint64_t board);
+
+	/**
+		Cancels the running request, e.g. because the board changed. Its future receives the status Cancelled.
+	*/
+	void cancel();
+};
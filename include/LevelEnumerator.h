@@ -0,0 +1,99 @@
+#pragma once
+#include <vector>
+#include <ostream>
+#include <cstddef>
+#include <cstdint>
+#include "BoardLayout.h"
+
+
+/**
+	Parallel breadth first search over the peg count levels of a board layout.
+	Every move changes the peg count by exactly one, so a level is expanded as a whole into the next one (level synchronous).
+	The expansion of a level runs in three phases, each spread over all worker threads:
+	1. every worker expands a slice of the level and distributes the canonical successors by hash into one bucket per shard,
+	2. every worker collects the buckets of its shards and removes duplicates by radix sort and unique,
+	3. the shards are merged into the sorted next level, every worker merging one key range.
+*/
+class LevelEnumerator {
+public:
+	/**
+		Describes whether a level is expanded by jumps (one peg less) or reverse jumps (one peg more).
+	*/
+	enum class Direction {
+		Forward,
+		Backward,
+	};
+
+	/**
+		Counters collected during the expansion of one level.
+	*/
+	struct LevelStats {
+		unsigned int pegs{ 0 }; // peg count of the expanded level
+		std::size_t states{ 0 }; // number of boards of the expanded level
+		std::size_t generatedStates{ 0 }; // number of successors generated, including duplicates
+		std::size_t uniqueStates{ 0 }; // number of distinct canonical successors
+		double seconds{ 0.0 }; // wall time of the expansion
+
+		double statesPerSecond() const {
+			return seconds > 0.0 ? static_cast<double>(generatedStates) / seconds : 0.0;
+		}
+	};
+
+private:
+	const BoardLayout& m_layout;
+	unsigned int m_threadCount;
+	std::vector<LevelStats> m_stats{};
+
+public:
+	/**
+		Creates an enumerator for a board layout.
+		\param layout The layout of the board
+		\param threadCount The number of worker threads (0 uses all hardware threads)
+	*/
+	explicit LevelEnumerator(const BoardLayout& layout, unsigned int threadCount = 0);
+
+	/**
+		Gets the layout the enumerator works on.
+	*/
+	const BoardLayout& getLayout() const {
+		return m_layout;
+	}
+
+	/**
+		Gets the number of worker threads.
+	*/
+	unsigned int getThreadCount() const {
+		return m_threadCount;
+	}
+
+	/**
+		Gets the counters of all levels expanded so far.
+	*/
+	const std::vector<LevelStats>& getStats() const {
+		return m_stats;
+	}
+
+	/**
+		Expands a level into all canonical boards one move away.
+		Forward successors which a pagoda function proves unsolvable are dropped.
+		\param level The canonical grid bitboards of the level (all with the same peg count)
+		\param direction Forward for the successors, backward for the predecessors
+		\return The sorted distinct canonical grid bitboards of the next level
+	*/
+	std::vector<uint64_t> expand(const std::vector<uint64_t>& level, Direction direction);
+
+	/**
+		Sorts 64 bit keys in place by a least significant digit radix sort with 16 bit digits.
+		Digits that are equal for all keys are skipped, so sparse grid bitboards need fewer passes.
+		\param keys The keys to sort
+		\param buffer Scratch memory, resized to the number of keys
+	*/
+	static void radixSort(std::vector<uint64_t>& keys, std::vector<uint64_t>& buffer);
+};
+
+
+inline std::ostream& operator<<(std::ostream& os, const LevelEnumerator::LevelStats& stats) {
+	return os << "Level " << stats.pegs << ": " << stats.states << " boards expanded into " << stats.generatedStates
+		<< " successors (" << stats.uniqueStates << " distinct) in " << stats.seconds << " s, "
+		<< static_cast<uint64_t>(stats.statesPerSecond()) << " states/s";
+}
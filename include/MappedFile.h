@@ -0,0 +1,54 @@
+#pragma once
+#include <string>
+#include <cstddef>
+
+
+/**
+	Read-only memory mapping of a file.
+	The operating system pages the content in on first access, so opening even a large file is cheap
+	and only the parts that are actually read are loaded from disk.
+*/
+class MappedFile {
+private:
+	const std::byte* m_data{ nullptr }; // start of the mapped view
+	std::size_t m_size{ 0 }; // size of the file in bytes
+#if defined(_WIN32)
+	void* m_fileHandle{ nullptr };
+	void* m_mappingHandle{ nullptr };
+#else
+	int m_fileDescriptor{ -1 };
+#endif
+
+	void close();
+
+public:
+	MappedFile() = default;
+
+	/**
+		Maps a file into memory.
+		\param path The path of the file
+		\throws std::runtime_error If the file cannot be opened or mapped
+	*/
+	explicit MappedFile(const std::string& path);
+
+	~MappedFile();
+
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+	MappedFile(MappedFile&& other) noexcept;
+	MappedFile& operator=(MappedFile&& other) noexcept;
+
+	/**
+		Gets the start of the mapped content.
+	*/
+	const std::byte* data() const {
+		return m_data;
+	}
+
+	/**
+		Gets the size of the mapped content in bytes.
+	*/
+	std::size_t size() const {
+		return m_size;
+	}
+};
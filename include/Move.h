@@ -10,11 +10,9 @@ struct Move {
 	CoordType over;
 	CoordType to;
 
-	Move(CoordType from, CoordType over, CoordType to) {
-		this->from = from;
-		this->over = over;
-		this->to = to;
-	}
+	constexpr Move() : from{}, over{}, to{} {}
+
+	constexpr Move(CoordType from, CoordType over, CoordType to) : from{ from }, over{ over }, to{ to } {}
 };
 
 using MovePair = Move<std::pair<int, int>>; // For 2D coordinates (improved readability)
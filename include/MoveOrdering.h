@@ -0,0 +1,93 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include "BoardLayout.h"
+#include "Move.h"
+
+
+/**
+	Describes how the solver searches a board.
+	The solver of every built-in board starts with the strategy which needed the fewest nodes to the first solution
+	on random boards of the board, as printed by starting the game with --compare-strategies.
+*/
+enum class SearchStrategy {
+	DepthFirst, // tries the jumps by direction and field, i.e. in the order they are generated
+	OrderedDepthFirst, // tries the jumps of every board best first according to the MoveOrdering heuristics
+	Beam, // keeps only the best boards of every level, if this finds no solution the ordered depth-first search decides
+};
+
+
+/**
+	Heuristic evaluation of boards, used to order the moves of the solver. A board scores higher the
+	- more slack its tightest pagoda function leaves above the goal value (a board without slack is about to be pruned),
+	- closer its pegs are to the goal field,
+	- fewer of its pegs are isolated, i.e. have no peg on a neighboring field (such a peg needs another peg to jump next to it).
+*/
+template <typename Board>
+struct BasicMoveOrdering {
+	static constexpr int kPagodaWeight = 2;
+	static constexpr int kDistanceWeight = 1;
+	static constexpr int kIsolationWeight = 4;
+
+	std::size_t cols{ 0 };
+	Board fields{};
+	Board notFirstCol{}; // fields which have a left neighbor column on the grid
+	Board notLastCol{}; // fields which have a right neighbor column on the grid
+	std::array<int, kBitboardBits<Board>> goalDistances{}; // Manhattan distance of every grid bit to the goal field
+
+	explicit BasicMoveOrdering(const BasicBoardLayout<Board>& layout) : cols{ layout.cols }, fields{ layout.fields } {
+		const unsigned int goal = lowestBitIndex(layout.solutionBoard);
+		const int goalRow = static_cast<int>(goal / cols);
+		const int goalCol = static_cast<int>(goal % cols);
+		for (Board remaining = fields; remaining != Board{}; remaining = withoutLowestBit(remaining)) {
+			const unsigned int bit = lowestBitIndex(remaining);
+			const int row = static_cast<int>(bit / cols);
+			const int col = static_cast<int>(bit % cols);
+			goalDistances[bit] = std::abs(row - goalRow) + std::abs(col - goalCol);
+			if (col != 0) {
+				notFirstCol |= singleBit<Board>(bit);
+			}
+			if (col + 1 != static_cast<int>(cols)) {
+				notLastCol |= singleBit<Board>(bit);
+			}
+		}
+	}
+
+	/**
+		Gets the pegs of a grid bitboard without a peg on any of their neighboring fields.
+	*/
+	Board isolatedPegs(const Board& board) const {
+		const Board neighbors = ((board & notLastCol) << 1) | ((board & notFirstCol) >> 1) | (board << cols) | (board >> cols);
+		return board & ~neighbors;
+	}
+
+	/**
+		Scores a move relative to the other moves of the same board.
+		\param move The move in grid bits
+		\param successor The grid bitboard after the move
+		\param pagodaSlack The smallest difference of a pagoda value of the successor to its goal value
+	*/
+	int scoreMove(const MoveByte& move, const Board& successor, int pagodaSlack) const {
+		const int distanceDelta = goalDistances[move.to] - goalDistances[move.from] - goalDistances[move.over];
+		return kPagodaWeight * pagodaSlack - kDistanceWeight * distanceDelta
+			- kIsolationWeight * static_cast<int>(pegCount(isolatedPegs(successor)));
+	}
+
+	/**
+		Scores a board, consistent with scoreMove() up to a constant for all successors of the same board.
+		\param board The grid bitboard
+		\param pagodaSlack The smallest difference of a pagoda value of the board to its goal value
+	*/
+	int scoreBoard(const Board& board, int pagodaSlack) const {
+		int distanceSum = 0;
+		for (Board pegs = board; pegs != Board{}; pegs = withoutLowestBit(pegs)) {
+			distanceSum += goalDistances[lowestBitIndex(pegs)];
+		}
+		return kPagodaWeight * pagodaSlack - kDistanceWeight * distanceSum
+			- kIsolationWeight * static_cast<int>(pegCount(isolatedPegs(board)));
+	}
+};
+
+using MoveOrdering = BasicMoveOrdering<uint64_t>;
@@ -0,0 +1,133 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <limits>
+#include <cstdint>
+
+
+/**
+	Flag to cancel a search from another thread. The search notices it at its next budget check.
+*/
+class CancelToken {
+private:
+	std::atomic<bool> m_isCancelled{ false };
+
+public:
+	void cancel() {
+		m_isCancelled.store(true, std::memory_order_relaxed);
+	}
+
+	/**
+		Clears the flag, so the token can be handed to the next search.
+	*/
+	void reset() {
+		m_isCancelled.store(false, std::memory_order_relaxed);
+	}
+
+	bool isCancelled() const {
+		return m_isCancelled.load(std::memory_order_relaxed);
+	}
+};
+
+
+/**
+	Outcome of a call of solve().
+*/
+struct SolveResult {
+	/**
+		Describes how the search ended.
+		- Solved: a solution was found
+		- Unsolvable: the search was completed, no solution exists
+		- TimedOut: the deadline passed or the node budget was used up before the search was completed
+		- Cancelled: the cancel token was set before the search was completed
+	*/
+	enum class Status {
+		Solved,
+		Unsolvable,
+		TimedOut,
+		Cancelled,
+	};
+
+	Status status{ Status::Unsolvable };
+	uint64_t nodesExplored{ 0 }; // number of board states expanded by the search (of all threads)
+
+	bool isSolved() const {
+		return status == Status::Solved;
+	}
+};
+
+
+/**
+	Limits of one search: a deadline on the monotonic clock, a budget of explored nodes and an optional cancel token.
+	The search charges the nodes it explored every kCheckInterval nodes, only then the clock is read and the token is checked,
+	so the limits cost nothing per node and are overrun by at most kCheckInterval nodes per thread.
+	All threads of a parallel search charge the same budget.
+*/
+class SearchBudget {
+public:
+	static constexpr uint64_t kCheckInterval = 4096; // nodes explored between two checks of the limits
+	static constexpr uint64_t kUnlimitedNodes = std::numeric_limits<uint64_t>::max();
+
+private:
+	std::chrono::steady_clock::time_point m_deadline;
+	uint64_t m_nodeBudget;
+	const CancelToken* m_cancelToken;
+	std::atomic<uint64_t> m_chargedNodes{ 0 };
+	std::atomic<bool> m_isTimedOut{ false };
+	std::atomic<bool> m_isCancelled{ false };
+
+public:
+	/**
+		Creates a budget starting now.
+		\param timeout The time the search may take (duration::max() for no deadline)
+		\param nodeBudget The number of nodes the search may explore
+		\param cancelToken The token cancelling the search, which has to outlive the search (nullptr if it cannot be cancelled)
+	*/
+	explicit SearchBudget(std::chrono::steady_clock::duration timeout, uint64_t nodeBudget = kUnlimitedNodes, const CancelToken* cancelToken = nullptr)
+		: m_nodeBudget{ nodeBudget }, m_cancelToken{ cancelToken } {
+		const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+		m_deadline = timeout < std::chrono::steady_clock::time_point::max() - now ? now + timeout : std::chrono::steady_clock::time_point::max();
+	}
+
+	/**
+		Creates a budget without any limit, i.e. the search only ends when it is completed.
+	*/
+	static SearchBudget unlimited(const CancelToken* cancelToken = nullptr) {
+		return SearchBudget(std::chrono::steady_clock::duration::max(), kUnlimitedNodes, cancelToken);
+	}
+
+	/**
+		Charges the nodes explored since the last call and checks all limits. Safe to call from any thread.
+		\param nodes The number of nodes explored since the last call
+		\return True if the search may go on, false if a limit is reached
+	*/
+	bool charge(uint64_t nodes) {
+		if (m_isTimedOut.load(std::memory_order_relaxed) || m_isCancelled.load(std::memory_order_relaxed)) {
+			return false;
+		}
+		if (m_cancelToken && m_cancelToken->isCancelled()) {
+			m_isCancelled.store(true, std::memory_order_relaxed);
+			return false;
+		}
+		const uint64_t chargedNodes = m_chargedNodes.fetch_add(nodes, std::memory_order_relaxed) + nodes;
+		if (chargedNodes > m_nodeBudget || std::chrono::steady_clock::now() >= m_deadline) {
+			m_isTimedOut.store(true, std::memory_order_relaxed);
+			return false;
+		}
+		return true;
+	}
+
+	/**
+		Gets the status of a search that ended without a solution: Cancelled or TimedOut if it was stopped by a limit,
+		Unsolvable if it was completed.
+	*/
+	SolveResult::Status stopStatus() const {
+		if (m_isCancelled.load(std::memory_order_relaxed)) {
+			return SolveResult::Status::Cancelled;
+		}
+		if (m_isTimedOut.load(std::memory_order_relaxed)) {
+			return SolveResult::Status::TimedOut;
+		}
+		return SolveResult::Status::Unsolvable;
+	}
+};
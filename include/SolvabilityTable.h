@@ -0,0 +1,163 @@
+#pragma once
+#include <array>
+#include <vector>
+#include <string>
+#include <optional>
+#include <atomic>
+#include <map>
+#include <memory>
+#include <cstddef>
+#include <cstdint>
+#include "BoardLayout.h"
+#include "LevelEnumerator.h"
+#include "BoardDefinition.h"
+#include "MappedFile.h"
+#include "Move.h"
+
+
+/**
+	Precomputed table of all winnable boards reachable from the initial board of a loaded board.
+	The table is generated once offline and written to a file, which holds for every peg count the sorted canonical
+	grid bitboards of the winnable boards. At runtime the file is memory mapped, so a hint costs a few binary searches
+	instead of a search of the game tree.
+
+	File format (version 3, native byte order):
+	- FileHeader: grid width, fields, goal board, symmetry group and start board of the board and for each peg count offset, size and checksum of its keys
+	- the keys of every peg count, each level starting at a page boundary so that a lookup only faults in the pages of its level
+*/
+class SolvabilityTable {
+public:
+	static constexpr std::size_t kLevelCount = 65; // peg counts 0 to 64
+	static constexpr uint32_t kVersion = 3;
+	static constexpr std::size_t kPageSize = 4096; // alignment of the levels within the file
+
+	/**
+		Position of the keys of one peg count within the file.
+	*/
+	struct LevelEntry {
+		uint64_t offset{ 0 }; // byte offset from the start of the file
+		uint64_t size{ 0 }; // number of keys
+		uint64_t checksum{ 0 }; // checksum of the keys
+	};
+
+	/**
+		Layout of the start of a table file.
+	*/
+	struct FileHeader {
+		std::array<char, 8> magic{ { 'P', 'E', 'G', 'S', 'O', 'L', 'V', '\0' } };
+		uint32_t version{ kVersion };
+		uint32_t cols{ 0 }; // width of the grid of the board the table was generated for
+		uint32_t fieldCount{ 0 }; // number of fields (holes) of the board
+		uint32_t symmetryGroup{ 0 }; // BoardLayout::symmetryGroup the keys are canonicalized with
+		uint64_t fields{ 0 }; // all fields of the board as grid bitboard
+		uint64_t solutionBoard{ 0 }; // goal board as grid bitboard
+		uint64_t startBoard{ 0 }; // initial board in compact format, whose reachable winnable boards are stored
+		std::array<LevelEntry, kLevelCount> levels{};
+		uint64_t headerChecksum{ 0 }; // checksum of all previous bytes of the header
+	};
+
+	using Levels = std::array<std::vector<uint64_t>, kLevelCount>; // sorted canonical grid bitboards per peg count
+
+private:
+	/**
+		Verification state of the keys of one peg count, checked on first access.
+	*/
+	enum LevelState : uint8_t {
+		Unchecked,
+		Valid,
+		Corrupt,
+	};
+
+	MappedFile m_file;
+	const BoardLayout& m_layout;
+	FileHeader m_header{};
+	mutable std::array<std::atomic<uint8_t>, kLevelCount> m_levelStates{};
+
+	/**
+		Gets the keys of one peg count and verifies their checksum on first access.
+		\throws std::runtime_error If the keys do not match their checksum
+	*/
+	const uint64_t* levelKeys(unsigned int pegs) const;
+
+public:
+	/**
+		Computes the checksum of a block of 64 bit words (FNV-1a on words).
+	*/
+	static uint64_t checksum(const std::byte* data, std::size_t size);
+
+	/**
+		Gets the default path of the table file of a board file, i.e. assets/tables/<name of the board file>.pst.
+	*/
+	static std::string defaultPath(const std::string& boardPath);
+
+	/**
+		Enumerates all boards reachable from the start board.
+		The boards are enumerated level by level, as every move removes exactly one peg. Boards which a pagoda function proves
+		unsolvable are dropped right away, which is safe as every predecessor of a winnable board is winnable itself.
+		\param enumerator The enumerator of the board layout expanding the levels
+		\param startBoard The initial board in compact format
+		\return The sorted canonical grid bitboards of all reachable boards per peg count, except the unsolvable ones dropped
+	*/
+	static Levels enumerateReachable(LevelEnumerator& enumerator, uint64_t startBoard);
+
+	/**
+		Enumerates all winnable boards reachable from the start board by a retrograde breadth first search.
+		Starting at the goal board, the reverse jumps of a level give the boards of the next higher level from which it can be reached.
+		Every board on the winning path of a reachable board is reachable itself, so each level is intersected with the
+		reachable boards before it is expanded and the search never leaves the winnable boards.
+		\param enumerator The enumerator of the board layout expanding the levels
+		\param startBoard The initial board in compact format
+		\return The sorted canonical grid bitboards of all winnable boards per peg count
+	*/
+	static Levels enumerateWinnable(LevelEnumerator& enumerator, uint64_t startBoard);
+
+	/**
+		Writes the winnable boards of a board into a table file.
+		\param path The path of the table file (missing directories are created)
+		\param board The board
+		\param startBoard The initial board in compact format the levels were enumerated from
+		\param levels The sorted canonical grid bitboards of the winnable boards per peg count
+		\throws std::runtime_error If the file cannot be written
+	*/
+	static void write(const std::string& path, const LoadedBoard& board, uint64_t startBoard, const Levels& levels);
+
+	/**
+		Opens a table file. Only the header is read, the levels are paged in by the first lookup touching them.
+		\param path The path of the table file
+		\param board The board the table has to belong to, which has to outlive the table
+		\throws std::runtime_error If the file cannot be mapped or is no valid table of the board and its start board
+	*/
+	SolvabilityTable(const std::string& path, const LoadedBoard& board);
+
+	/**
+		Gets the initial board (in compact format) the table was generated from.
+	*/
+	uint64_t getStartBoard() const {
+		return m_header.startBoard;
+	}
+
+	/**
+		Checks whether the goal can still be reached from a grid bitboard.
+		Only boards reachable from the start board are contained in the table.
+		\throws std::runtime_error If the level of the board is corrupt
+	*/
+	bool isWinnable(uint64_t gridBoard) const;
+
+	/**
+		Finds all moves which keep the board winnable.
+		\param board The board in compact format
+		\return The moves in compact bit indices, empty if the board cannot be solved anymore
+		\throws std::runtime_error If a level needed for the lookup is corrupt
+	*/
+	std::vector<MoveByte> findWinningMoves(uint64_t board) const;
+
+	/**
+		Finds a move which keeps the board winnable.
+		\param board The board in compact format
+		\return The move in compact bit indices, or std::nullopt if the board cannot be solved anymore
+		\throws std::runtime_error If a level needed for the lookup is corrupt
+	*/
+	std::optional<MoveByte> findWinningMove(uint64_t board) const;
+};
+
+using SolvabilityTables = std::map<const LoadedBoard*, std::unique_ptr<SolvabilityTable>>; // the tables available per board of the game
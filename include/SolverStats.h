@@ -0,0 +1,32 @@
+#pragma once
+#include <ostream>
+#include <cstdint>
+
+
+/**
+	Counters collected during a single call of Solver::solve().
+*/
+struct SolverStats {
+	uint64_t nodesExplored{ 0 }; // number of board states expanded by the search
+	uint64_t transpositionHits{ 0 }; // number of board states cut because they (or a symmetric image) were already visited
+	uint64_t pagodaPrunes{ 0 }; // number of board states cut because a pagoda function proves them unsolvable
+	uint64_t positionClassRejections{ 0 }; // number of searches skipped because the position class of the board differs from the goal
+	uint64_t heapAllocations{ 0 }; // number of heap allocations made by the solver during the search
+	uint64_t tableCapacity{ 0 }; // number of slots of the transposition table
+	uint64_t tableEntries{ 0 }; // number of occupied slots of the transposition table after the search
+	uint64_t tableCollisions{ 0 }; // number of insertions whose home slot was occupied by another board
+	uint64_t tableReplacements{ 0 }; // number of boards evicted from the transposition table because their bucket was full
+
+	double tableFillRatio() const {
+		return tableCapacity == 0 ? 0.0 : static_cast<double>(tableEntries) / static_cast<double>(tableCapacity);
+	}
+};
+
+
+inline std::ostream& operator<<(std::ostream& os, const SolverStats& stats) {
+	return os << "Explored nodes: " << stats.nodesExplored << ", transposition hits: " << stats.transpositionHits
+		<< ", pagoda prunes: " << stats.pagodaPrunes << ", position class rejections: " << stats.positionClassRejections
+		<< ", table fill ratio: " << stats.tableFillRatio() << " (" << stats.tableEntries << '/' << stats.tableCapacity << ")"
+		<< ", collisions: " << stats.tableCollisions << ", replacements: " << stats.tableReplacements
+		<< ", heap allocations: " << stats.heapAllocations;
+}
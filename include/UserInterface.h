@@ -15,6 +15,7 @@ private:
 	GameLogic& m_gameLogic; // The game logic instance that manages the game state and rules
 	sf::RenderWindow m_window{ sf::VideoMode({ 800, 800 }), "Peg Solitaire", sf::Style::Titlebar | sf::Style::Close }; // The main window for the game
 	std::map<Field*, sf::CircleShape> fieldToShape{}; // Maps the game fields to their corresponding graphical shapes
+	bool m_showPlayablePegs{ false }; // Whether the pegs which can jump are outlined
 
 public:
 	/**
@@ -36,7 +37,7 @@ public:
 	void drawBackground(std::filesystem::path filename);
 
 	/**
-		Draws the goal field at the specified row and column on the game board (depends on board type).
+		Draws the goal field at the specified row and column on the game board (one of the pegs of the goal board).
 		\param row The row index of the goal field
 		\param col The column index of the goal field
 	*/
@@ -80,6 +81,11 @@ public:
 	*/
 	void drawGameWonText();
 
+	/**
+		Switches the outlining of the pegs which can jump on or off (redrawn every frame from the game logic).
+	*/
+	void togglePlayablePegs();
+
 	/**
 		Highlights the next possible move to find a valid solution.
 	*/
@@ -91,7 +97,7 @@ public:
 	void render();
 
 	/**
-		Resets the field shapes to match the current type of the game board.
+		Resets the field shapes to match the board currently played.
 	*/
 	void resetFieldToShape();
 
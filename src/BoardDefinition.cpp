@@ -0,0 +1,322 @@
+#include "BoardDefinition.h"
+#include <sstream>
+#include <fstream>
+#include <filesystem>
+#include <algorithm>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+#include <optional>
+#include <cctype>
+#include <cstring>
+#include "SolvabilityTable.h"
+#include "MappedFile.h"
+
+
+// Names of the elements of D4 in the order of BasicBoardTables::transform (the identity is always used)
+static constexpr std::array<const char*, 8> kSymmetryNames{ "identity", "flip-lr", "flip-ud", "rot180", "transpose", "antitranspose", "rot90", "rot270" };
+
+/**
+	Computes the checksum of the content of a board file (FNV-1a on bytes, as the length is no multiple of 8).
+*/
+static uint64_t sourceChecksum(const std::string& content) {
+	uint64_t hash = 0xCBF29CE484222325ULL;
+	for (const char byte : content) {
+		hash = (hash ^ static_cast<uint8_t>(byte)) * 0x100000001B3ULL;
+	}
+	return hash;
+}
+
+static std::invalid_argument parseError(const std::string& source, std::size_t lineIdx, const std::string& message) {
+	return std::invalid_argument(source + ":" + std::to_string(lineIdx) + ": " + message);
+}
+
+/**
+	Creates a loaded board from its tables, which builds the layout of the board.
+*/
+template <typename GridBoard>
+static AnyLoadedBoard makeLoadedBoard(const std::string& name, const BasicBoardTables<GridBoard>& tables, const std::vector<std::vector<int>>& pagodaWeights) {
+	return std::make_unique<const BasicLoadedBoard<GridBoard>>(
+		BasicLoadedBoard<GridBoard>{ name, tables, pagodaWeights, BasicBoardLayout<GridBoard>::build(tables, pagodaWeights) });
+}
+
+/**
+	Gets the loaded board of the content of a cache file, if the content has the size of the tables of the bitboard type.
+*/
+template <typename GridBoard>
+static std::optional<AnyLoadedBoard> cachedBoard(const BoardDefinition::CacheHeader& header, const std::byte* data, std::size_t size) {
+	BasicBoardTables<GridBoard> tables;
+	if (header.tablesSize != sizeof(tables) || size < sizeof(tables)) {
+		return std::nullopt;
+	}
+	std::memcpy(&tables, data, sizeof(tables));
+	if (size != sizeof(tables) + header.pagodaCount * tables.fieldCount * sizeof(int64_t)) {
+		return std::nullopt;
+	}
+	std::vector<std::vector<int>> pagodaWeights(header.pagodaCount, std::vector<int>(tables.fieldCount));
+	const std::byte* weightData = data + sizeof(tables);
+	for (std::vector<int>& weights : pagodaWeights) {
+		for (int& weight : weights) {
+			int64_t storedWeight;
+			std::memcpy(&storedWeight, weightData, sizeof(storedWeight));
+			weight = static_cast<int>(storedWeight);
+			weightData += sizeof(storedWeight);
+		}
+	}
+	return makeLoadedBoard(header.name.data(), tables, pagodaWeights);
+}
+
+/**
+	Reads the tables of a board from its cache file, if the file was compiled from the given board file content.
+*/
+static std::optional<AnyLoadedBoard> readCache(const std::string& cachePath, uint64_t checksum) {
+	if (!std::filesystem::exists(cachePath)) {
+		return std::nullopt;
+	}
+	const MappedFile file(cachePath);
+	BoardDefinition::CacheHeader header;
+	if (file.size() < sizeof(header)) {
+		return std::nullopt;
+	}
+	std::memcpy(&header, file.data(), sizeof(header));
+	if (header.magic != BoardDefinition::CacheHeader{}.magic || header.version != BoardDefinition::kCacheVersion
+		|| header.headerChecksum != SolvabilityTable::checksum(file.data(), offsetof(BoardDefinition::CacheHeader, headerChecksum))
+		|| header.sourceChecksum != checksum) {
+		return std::nullopt;
+	}
+	const std::byte* data = file.data() + sizeof(header);
+	const std::size_t size = file.size() - sizeof(header);
+	if (SolvabilityTable::checksum(data, size) != header.contentChecksum) {
+		return std::nullopt;
+	}
+	switch (header.gridWords) {
+	case 1:
+		return cachedBoard<uint64_t>(header, data, size);
+	case 2:
+		return cachedBoard<Bitboard<2>>(header, data, size);
+	case 4:
+		return cachedBoard<Bitboard<4>>(header, data, size);
+	default:
+		return std::nullopt;
+	}
+}
+
+/**
+	Writes the tables of a loaded board into its cache file.
+*/
+template <typename GridBoard>
+static void writeCache(const std::string& cachePath, uint64_t checksum, const BasicLoadedBoard<GridBoard>& board) {
+	static_assert(std::is_trivially_copyable_v<BasicBoardTables<GridBoard>>, "The tables are cached as they are in memory.");
+	const std::filesystem::path filePath(cachePath);
+	if (filePath.has_parent_path()) {
+		std::filesystem::create_directories(filePath.parent_path());
+	}
+	std::ofstream file(filePath, std::ios::binary | std::ios::trunc);
+	if (!file) {
+		throw std::runtime_error("Failed to create " + cachePath + ".");
+	}
+
+	std::vector<std::byte> content(sizeof(board.tables));
+	std::memcpy(content.data(), &board.tables, sizeof(board.tables));
+	for (const std::vector<int>& weights : board.pagodaWeights) {
+		for (const int weight : weights) {
+			const int64_t storedWeight = weight;
+			const std::byte* bytes = reinterpret_cast<const std::byte*>(&storedWeight);
+			content.insert(content.end(), bytes, bytes + sizeof(storedWeight));
+		}
+	}
+
+	BoardDefinition::CacheHeader header;
+	header.gridWords = static_cast<uint32_t>(kBitboardWords<GridBoard>);
+	header.tablesSize = sizeof(board.tables);
+	header.pagodaCount = board.pagodaWeights.size();
+	header.contentChecksum = SolvabilityTable::checksum(content.data(), content.size());
+	header.sourceChecksum = checksum;
+	std::copy_n(board.name.begin(), std::min(board.name.size(), BoardDefinition::kMaxNameLength), header.name.begin());
+	header.headerChecksum = SolvabilityTable::checksum(reinterpret_cast<const std::byte*>(&header), offsetof(BoardDefinition::CacheHeader, headerChecksum));
+
+	file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+	file.write(reinterpret_cast<const char*>(content.data()), static_cast<std::streamsize>(content.size()));
+	if (!file) {
+		throw std::runtime_error("Failed to write " + cachePath + ".");
+	}
+}
+
+
+BoardDefinition BoardDefinition::parse(std::istream& input, const std::string& source) {
+	BoardDefinition definition;
+	std::vector<std::string> gridRows;
+	bool isGrid = false;
+	std::size_t gridLineIdx = 0;
+	std::string line;
+	for (std::size_t lineIdx = 1; std::getline(input, line); ++lineIdx) {
+		line = line.substr(0, line.find('#'));
+		line.erase(std::find_if(line.rbegin(), line.rend(), [](unsigned char c) { return !std::isspace(c); }).base(), line.end());
+		if (line.empty()) {
+			continue;
+		}
+		if (isGrid) {
+			if (line.find_first_not_of("o.-") != std::string::npos) {
+				throw parseError(source, lineIdx, "A row of the grid may only contain 'o' (peg), '.' (empty field) and '-' (no field).");
+			}
+			gridRows.push_back(line);
+			continue;
+		}
+
+		std::istringstream statement(line);
+		std::string keyword;
+		statement >> keyword;
+		if (keyword == "name") {
+			std::getline(statement >> std::ws, definition.name);
+			if (definition.name.empty() || definition.name.size() > kMaxNameLength) {
+				throw parseError(source, lineIdx, "The name has to have 1 to " + std::to_string(kMaxNameLength) + " characters.");
+			}
+		} else if (keyword == "goal") {
+			std::vector<int> coordinates{ std::istream_iterator<int>(statement), std::istream_iterator<int>() };
+			for (std::size_t idx = 0; idx + 1 < coordinates.size(); idx += 2) {
+				definition.goal.emplace_back(coordinates[idx], coordinates[idx + 1]);
+			}
+			if (coordinates.empty() || coordinates.size() % 2 != 0 || !statement.eof()) {
+				throw parseError(source, lineIdx, "The goal has to be given as pairs of row and column.");
+			}
+		} else if (keyword == "symmetries") {
+			definition.symmetryGroup = 1;
+			std::string symmetryName;
+			while (statement >> symmetryName) {
+				const auto symmetry = std::find(kSymmetryNames.begin() + 1, kSymmetryNames.end(), symmetryName);
+				if (symmetry != kSymmetryNames.end()) {
+					definition.symmetryGroup |= static_cast<uint8_t>(1U << std::distance(kSymmetryNames.begin(), symmetry));
+				} else if (symmetryName != "none") {
+					throw parseError(source, lineIdx, "Unknown symmetry " + symmetryName + ".");
+				}
+			}
+		} else if (keyword == "pagoda") {
+			definition.pagodaWeights.emplace_back(std::istream_iterator<int>(statement), std::istream_iterator<int>());
+			if (!statement.eof()) {
+				throw parseError(source, lineIdx, "The weights of a pagoda function have to be integers.");
+			}
+		} else if (keyword == "grid" && statement.eof()) {
+			isGrid = true;
+			gridLineIdx = lineIdx;
+		} else {
+			throw parseError(source, lineIdx, "Unknown statement " + keyword + ".");
+		}
+	}
+
+	if (gridRows.empty()) {
+		throw parseError(source, gridLineIdx, "The board file has no grid.");
+	}
+	definition.rows = gridRows.size();
+	for (const std::string& gridRow : gridRows) {
+		definition.cols = std::max(definition.cols, gridRow.size());
+	}
+	if (definition.rows > kMaxGridLength || definition.cols > kMaxGridLength || definition.rows * definition.cols >= BoardTables::kNoField) {
+		throw parseError(source, gridLineIdx, "The grid has more than " + std::to_string(kMaxGridLength) + " rows or columns or more than "
+			+ std::to_string(BoardTables::kNoField - 1) + " cells.");
+	}
+	for (const std::string& gridRow : gridRows) {
+		for (std::size_t col = 0; col < definition.cols; ++col) {
+			const char cell = col < gridRow.size() ? gridRow[col] : '-';
+			definition.cells.push_back(cell == 'o' ? 1 : cell == '.' ? 0 : -1);
+		}
+	}
+	const std::size_t fieldCount = static_cast<std::size_t>(std::count_if(definition.cells.begin(), definition.cells.end(), [](int cell) { return cell >= 0; }));
+	for (const std::vector<int>& weights : definition.pagodaWeights) {
+		if (weights.size() != fieldCount) {
+			throw parseError(source, gridLineIdx, "A pagoda function needs a weight for each of the " + std::to_string(fieldCount) + " fields.");
+		}
+	}
+	if (definition.goal.empty()) {
+		if (std::count(definition.cells.begin(), definition.cells.end(), 0) != 1) {
+			throw parseError(source, gridLineIdx, "The goal has to be given unless the grid has exactly one empty field.");
+		}
+		const std::size_t cellIdx = static_cast<std::size_t>(std::find(definition.cells.begin(), definition.cells.end(), 0) - definition.cells.begin());
+		definition.goal.emplace_back(static_cast<int>(cellIdx / definition.cols), static_cast<int>(cellIdx % definition.cols));
+	}
+	for (const auto& [row, col] : definition.goal) {
+		if (row < 0 || col < 0 || row >= static_cast<int>(definition.rows) || col >= static_cast<int>(definition.cols)) {
+			throw parseError(source, gridLineIdx, "The goal (" + std::to_string(row) + ", " + std::to_string(col) + ") is outside of the grid.");
+		}
+	}
+	if (definition.name.empty()) {
+		definition.name = std::filesystem::path(source).stem().string();
+	}
+	return definition;
+}
+
+template <typename GridBoard>
+BasicBoardTables<GridBoard> BoardDefinition::compile() const {
+	BasicBoardTables<GridBoard> tables = buildBoardTables<GridBoard>(rows, cols,
+		[this](std::size_t row, std::size_t col) { return cells[row * cols + col]; },
+		[this](std::size_t row, std::size_t col) {
+			return std::find(goal.begin(), goal.end(), std::pair<int, int>(static_cast<int>(row), static_cast<int>(col))) != goal.end();
+		});
+	if (symmetryGroup == 0) {
+		return tables;
+	}
+	for (int symmetryIdx = 1; symmetryIdx < 8; ++symmetryIdx) {
+		if (((symmetryGroup >> symmetryIdx) & 1) != 0 && ((tables.symmetryGroup >> symmetryIdx) & 1) == 0) {
+			throw std::invalid_argument(std::string(kSymmetryNames[symmetryIdx]) + " is no symmetry of the board " + name + ".");
+		}
+	}
+	// Any subset of the symmetries is sound for the transposition table, the images of a board are still equivalent to it
+	tables.symmetryGroup = symmetryGroup;
+	return tables;
+}
+
+std::vector<std::string> BoardDefinition::listBoardFiles(const std::string& directory) {
+	std::vector<std::string> paths;
+	for (const std::filesystem::directory_entry& entry : std::filesystem::directory_iterator(directory)) {
+		if (entry.is_regular_file() && entry.path().extension() == ".board") {
+			paths.push_back(entry.path().string());
+		}
+	}
+	std::sort(paths.begin(), paths.end());
+	return paths;
+}
+
+std::string BoardDefinition::defaultCachePath(const std::string& path) {
+	return (std::filesystem::path("assets/tables") / std::filesystem::path(path).stem()).string() + ".pbt";
+}
+
+AnyLoadedBoard BoardDefinition::load(const std::string& path, const std::string& cachePath) {
+	std::ifstream file(path, std::ios::binary);
+	if (!file) {
+		throw std::runtime_error("Failed to open " + path + ".");
+	}
+	const std::string content{ std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>() };
+	const uint64_t checksum = sourceChecksum(content);
+
+	// A corrupt or outdated cache file is compiled again
+	try {
+		if (std::optional<AnyLoadedBoard> board = readCache(cachePath, checksum)) {
+			return std::move(*board);
+		}
+	} catch (const std::runtime_error&) {
+	}
+
+	std::istringstream input(content);
+	const BoardDefinition definition = parse(input, path);
+	AnyLoadedBoard board;
+	switch (definition.gridWords()) {
+	case 1:
+		board = makeLoadedBoard(definition.name, definition.compile<uint64_t>(), definition.pagodaWeights);
+		break;
+	case 2:
+		board = makeLoadedBoard(definition.name, definition.compile<Bitboard<2>>(), definition.pagodaWeights);
+		break;
+	default:
+		board = makeLoadedBoard(definition.name, definition.compile<Bitboard<4>>(), definition.pagodaWeights);
+		break;
+	}
+	try {
+		std::visit([&cachePath, checksum](const auto& loadedBoard) { writeCache(cachePath, checksum, *loadedBoard); }, board);
+	} catch (const std::exception&) {
+		// Without the cache file the board is compiled again by the next load
+	}
+	return board;
+}
+
+template BasicBoardTables<uint64_t> BoardDefinition::compile<uint64_t>() const;
+template BasicBoardTables<Bitboard<2>> BoardDefinition::compile<Bitboard<2>>() const;
+template BasicBoardTables<Bitboard<4>> BoardDefinition::compile<Bitboard<4>>() const;
@@ -0,0 +1,202 @@
+#include <array>
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <cstdlib>
+#include <stdexcept>
+#include "BoardLayout.h"
+#include "BoardTables.h"
+#include "Move.h"
+
+
+/**
+	Checks the move and jump tables of a board against all pairs of fields in a line with one field in between.
+	The moves of the tables are ordered by origin, so only the moves of the current origin are searched.
+*/
+template <typename Tables>
+static constexpr bool matchesBruteForceMoves(const Tables& tables) {
+	std::size_t moveCount = 0;
+	std::size_t firstMoveOfOrigin = 0;
+	for (std::size_t from = 0; from < tables.fieldCount; ++from) {
+		const auto [fromRow, fromCol] = tables.position(from);
+		std::size_t movesOfOrigin = 0;
+		for (std::size_t to = 0; to < tables.fieldCount; ++to) {
+			const auto [toRow, toCol] = tables.position(to);
+			const int rowDistance = toRow - fromRow;
+			const int colDistance = toCol - fromCol;
+			const bool isRowJump = rowDistance == 0 && (colDistance == 2 || colDistance == -2);
+			const bool isColJump = colDistance == 0 && (rowDistance == 2 || rowDistance == -2);
+			std::size_t over = tables.fieldCount;
+			for (std::size_t idx = 0; (isRowJump || isColJump) && idx < tables.fieldCount; ++idx) {
+				if (2 * tables.position(idx).first == fromRow + toRow && 2 * tables.position(idx).second == fromCol + toCol) {
+					over = idx;
+				}
+			}
+			if (over == tables.fieldCount) {
+				continue;
+			}
+			bool isListed = false;
+			for (std::size_t idx = firstMoveOfOrigin; idx < tables.moveCount && tables.moves[idx].from == from; ++idx) {
+				isListed = isListed || (tables.moves[idx].over == over && tables.moves[idx].to == to);
+			}
+			const std::size_t direction = isRowJump ? (colDistance > 0 ? JumpDirection::Right : JumpDirection::Left)
+				: (rowDistance > 0 ? JumpDirection::Down : JumpDirection::Up);
+			if (!isListed || (tables.jumpOrigins[direction] & singleBit<typename Tables::Board>(tables.bitIdxToGrid[from])) == typename Tables::Board{}) {
+				return false;
+			}
+			++movesOfOrigin;
+		}
+		firstMoveOfOrigin += movesOfOrigin;
+		moveCount += movesOfOrigin;
+	}
+	return moveCount == tables.moveCount;
+}
+
+static_assert(englishBoardTables.fieldCount == 33 && englishBoardTables.solutionBoard == 0x10000 && matchesBruteForceMoves(englishBoardTables),
+	"The tables of the English board do not match its initial grid.");
+static_assert(europeanBoardTables.fieldCount == 37 && europeanBoardTables.solutionBoard == 0x1000000000 && matchesBruteForceMoves(europeanBoardTables),
+	"The tables of the European board do not match its initial grid.");
+static_assert(asymmetricBoardTables.fieldCount == 39 && asymmetricBoardTables.solutionBoard == 0x100000 && matchesBruteForceMoves(asymmetricBoardTables),
+	"The tables of the asymmetric board do not match its initial grid.");
+static_assert(smallDiamondBoardTables.fieldCount == 32 && smallDiamondBoardTables.solutionBoard == 0x1000 && matchesBruteForceMoves(smallDiamondBoardTables),
+	"The tables of the small diamond board do not match its initial grid.");
+static_assert(wieglebBoardTables.fieldCount == 45 && wieglebBoardTables.solutionBoard == singleBit<Bitboard<2>>(22) && matchesBruteForceMoves(wieglebBoardTables),
+	"The tables of Wiegleb's board do not match its initial grid.");
+
+
+template <>
+const BoardLayout& BoardLayout::forBoardType(BoardType type) {
+	// The pagoda weights are given row by row in the compact bit indices of the board and are validated by addPagoda
+	switch (type) {
+	case BoardType::English: {
+		static const BoardLayout englishLayout = build(englishBoardTables, {
+			{ -1, 0, -1, 1, 1, 1, -1, 1, 0, 1, 0, 1, -1, 0, 1, 1, 2, 1, 1, 0, -1, 1, 0, 1, 0, 1, -1, 1, 1, 1, -1, 0, -1 },
+			{ -1, 0, -1, 1, 3, 1, 0, 0, 0, 0, 0, 0, 0, 0, 2, 1, 3, 1, 2, 0, 0, 0, 0, 0, 0, 0, 0, 1, 3, 1, -1, 0, -1 },
+			{ 0, 0, 0, 0, 2, 0, -2, 2, 0, 2, 0, 2, -2, 0, 0, 0, 0, 0, 0, 0, -2, 2, 0, 2, 0, 2, -2, 0, 1, 0, 0, 1, 0 },
+		});
+		return englishLayout;
+	}
+	case BoardType::European: {
+		static const BoardLayout europeanLayout = build(europeanBoardTables, {
+			{ -2, 2, -2, -2, 2, 0, 2, -2, -2, 2, 0, 2, 0, 2, -2, 2, 0, 2, 0, 2, 0, 2, -2, 2, 0, 2, 0, 2, -2, -2, 2, 0, 2, -2, -1, 2, 1 },
+			{ -1, 2, -1, -1, 1, 0, 1, -1, -2, 2, 0, 2, 0, 2, -2, 0, 1, 1, 0, 1, 1, 0, -2, 2, 0, 2, 0, 2, -2, -1, 1, 0, 1, -1, -1, 2, 1 },
+			{ -2, 0, -2, 0, 2, 1, 3, -2, -1, 1, 0, 1, 1, 2, -1, 1, 1, 2, 1, 2, 0, 2, -2, 2, 0, 2, 0, 2, -2, -1, 2, 0, 2, -2, -2, 2, 0 },
+		});
+		return europeanLayout;
+	}
+	case BoardType::Asymmetric: {
+		static const BoardLayout asymmetricLayout = build(asymmetricBoardTables, {
+			{ 0, 1, -1, 0, 1, 1, 0, 2, 0, -1, 1, 0, 1, 1, 0, 1, -1, 0, 3, 0, 3, 0, 3, 3, 0, -1, 1, 0, 1, 1, 0, 1, -1, 0, 2, 1, 0, 0, 0 },
+			{ -2, 0, -2, 2, 1, 2, 0, 1, 0, -1, 3, 2, 2, 2, 0, 2, -2, 0, 2, 2, 3, 2, 1, 1, 1, -1, 1, 0, 1, 1, 0, 1, -1, 2, 2, 3, -2, 0, -2 },
+			{ 0, 0, 0, 0, 3, 0, 0, 3, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 3, 0, 3, 0, 3, 2, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 3, 0, 0, 0, 0 },
+		});
+		return asymmetricLayout;
+	}
+	case BoardType::SmallDiamond: {
+		static const BoardLayout smallDiamondLayout = build(smallDiamondBoardTables, {
+			{ -1, 0, 1, 0, 0, 0, 0, 0, 0, -1, 1, 0, 1, 0, 1, -1, -1, 1, 0, 1, 0, 1, -1, 0, 0, 0, 0, 0, 0, 1, 0, -1 },
+			{ -2, 0, 3, 0, -1, 1, 0, 1, -1, -2, 3, 1, 3, 1, 3, -2, -2, 2, 0, 2, 0, 2, -2, 1, 1, 2, 1, 1, -1, 0, -1, 2 },
+			{ -2, 0, 2, 0, 0, 0, 0, 0, 0, -2, 2, 0, 2, 0, 2, -2, -1, 1, 0, 1, 0, 1, -1, 1, 0, 1, 0, 1, 0, 0, 0, 1 },
+		});
+		return smallDiamondLayout;
+	}
+	default:
+		throw std::invalid_argument("Unsupported built-in board for peg solitaire.");
+	}
+}
+
+template <typename GridBoard>
+BasicBoardLayout<GridBoard> BasicBoardLayout<GridBoard>::build(const BasicBoardTables<Board>& tables, const std::vector<std::vector<int>>& pagodaWeights) {
+	const int maxRow = static_cast<int>(tables.rows) - 1;
+	const int maxCol = static_cast<int>(tables.cols) - 1;
+
+	BasicBoardLayout layout;
+	layout.cols = tables.cols;
+	layout.gridToBitIdx = tables.gridToBitIdx;
+	layout.bitIdxToGrid = tables.bitIdxToGrid;
+	layout.fields = tables.fields;
+	layout.jumpOrigins = tables.jumpOrigins;
+	layout.solutionBoard = tables.gridSolutionBoard;
+
+	for (std::size_t idx = 0; idx < tables.fieldCount; ++idx) {
+		const auto [row, col] = tables.position(idx);
+		layout.diagonalClasses[0][(row + col) % 3] |= singleBit<Board>(tables.bitIdxToGrid[idx]);
+		layout.diagonalClasses[1][(row - col + 3 * maxCol) % 3] |= singleBit<Board>(tables.bitIdxToGrid[idx]);
+	}
+
+	// The symmetry group is determined with the tables, here only the images of the bytes of a board are precomputed
+	layout.symmetryGroup = tables.symmetryGroup;
+	for (int symmetryIdx = 1; symmetryIdx < 8; ++symmetryIdx) {
+		if ((tables.symmetryGroup & (1U << symmetryIdx)) == 0) {
+			continue;
+		}
+		std::array<uint8_t, kGridBits> permutation{};
+		for (std::size_t idx = 0; idx < tables.fieldCount; ++idx) {
+			const auto [row, col] = tables.transform(symmetryIdx, tables.position(idx));
+			permutation[tables.bitIdxToGrid[idx]] = tables.bitIdxToGrid[tables.bitIdx(row, col)];
+		}
+
+		Symmetry symmetry;
+		for (std::size_t byteIdx = 0; byteIdx < symmetry.byteImages.size(); ++byteIdx) {
+			for (std::size_t byteValue = 0; byteValue < 256; ++byteValue) {
+				Board image{};
+				for (std::size_t bit = 0; bit < 8; ++bit) {
+					const std::size_t gridIdx = byteIdx * 8 + bit;
+					if ((byteValue & (1ULL << bit)) && layout.gridToBitIdx[gridIdx] != BasicBoardTables<Board>::kNoField) {
+						image |= singleBit<Board>(permutation[gridIdx]);
+					}
+				}
+				symmetry.byteImages[byteIdx][byteValue] = image;
+			}
+		}
+		layout.symmetries.push_back(symmetry);
+	}
+
+	// Fibonacci numbers of the Manhattan distance to the goal field are a pagoda function on every board:
+	// a jump towards the goal keeps the value since F(n) = F(n - 1) + F(n - 2), every other jump decreases it
+	// (for a goal board of several pegs the distance to its first peg is used, the goal value is then the sum of their weights)
+	const auto goal = tables.position(lowestBitIndex(tables.solutionBoard));
+	const int maxDistance = maxRow + maxCol;
+	std::vector<int> fibonacci(static_cast<std::size_t>(maxDistance) + 3, 1);
+	fibonacci[0] = 0;
+	for (std::size_t n = 2; n < fibonacci.size(); ++n) {
+		fibonacci[n] = fibonacci[n - 1] + fibonacci[n - 2];
+		if (fibonacci[n] > 1000000) {
+			fibonacci[n] = fibonacci[n - 1]; // capping keeps the pagoda property, the weights stay non-decreasing
+		}
+	}
+	Pagoda distancePagoda;
+	for (std::size_t idx = 0; idx < tables.fieldCount; ++idx) {
+		const auto [row, col] = tables.position(idx);
+		const int distance = std::abs(row - goal.first) + std::abs(col - goal.second);
+		distancePagoda.weights[tables.bitIdxToGrid[idx]] = fibonacci[maxDistance + 2 - distance];
+	}
+	layout.addPagoda(distancePagoda);
+
+	for (const std::vector<int>& weights : pagodaWeights) {
+		Pagoda pagoda;
+		for (std::size_t idx = 0; idx < weights.size(); ++idx) {
+			pagoda.weights[layout.bitIdxToGrid[idx]] = weights[idx];
+		}
+		layout.addPagoda(pagoda);
+	}
+	return layout;
+}
+
+template <typename GridBoard>
+void BasicBoardLayout<GridBoard>::addPagoda(Pagoda pagoda) {
+	for (std::size_t direction = 0; direction < jumpOrigins.size(); ++direction) {
+		for (Board origins = jumpOrigins[direction]; origins != Board{}; origins = withoutLowestBit(origins)) {
+			if (pagoda.delta(gridMove(lowestBitIndex(origins), direction)) > 0) {
+				throw std::invalid_argument("The given weights are not a pagoda function of the board.");
+			}
+		}
+	}
+	pagoda.goalValue = pagoda.value(solutionBoard);
+	pagodas.push_back(pagoda);
+}
+
+// Layouts of the boards of the game and of larger boards (see BoardTraits.h)
+template struct BasicBoardLayout<uint64_t>;
+template struct BasicBoardLayout<Bitboard<2>>;
+template struct BasicBoardLayout<Bitboard<4>>;
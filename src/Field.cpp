@@ -2,20 +2,39 @@
 #include <utility>
 
 
-Field::Field(FieldState state, std::pair<int, int> position) : m_state{ state }, m_position{ position } {}
+Field::Field(uint64_t& pegs, uint64_t& selectedPegs, uint8_t bitIdx, std::pair<int, int> position)
+	: m_pegs{ &pegs }, m_selectedPegs{ &selectedPegs }, m_bitIdx{ bitIdx }, m_position{ position } {}
 
-const FieldState& Field::getState() const {
-	return m_state;
+FieldState Field::getState() const {
+	const uint64_t bit = 1ULL << m_bitIdx;
+	if (*m_selectedPegs & bit) {
+		return FieldState::Selected;
+	}
+	return (*m_pegs & bit) ? FieldState::Occupied : FieldState::Empty;
 }
 
 std::pair<int, int> Field::getPosition() const {
 	return m_position;
 }
 
-void Field::setState(const FieldState& state) {
-	m_state = state;
+uint8_t Field::getBitIdx() const {
+	return m_bitIdx;
 }
 
-void Field::setPosition(const std::pair<int, int>& position) {
-	m_position = position;
+void Field::setState(const FieldState& state) {
+	const uint64_t bit = 1ULL << m_bitIdx;
+	switch (state) {
+	case FieldState::Empty:
+		*m_pegs &= ~bit;
+		*m_selectedPegs &= ~bit;
+		break;
+	case FieldState::Occupied:
+		*m_pegs |= bit;
+		*m_selectedPegs &= ~bit;
+		break;
+	case FieldState::Selected:
+		*m_pegs |= bit; // a selected field still holds its peg
+		*m_selectedPegs |= bit;
+		break;
+	}
 }
\ No newline at end of file
@@ -0,0 +1,176 @@
+#include <chrono>
+#include <iostream>
+#include <stdexcept>
+#include <utility>
+#include "HintEngine.h"
+#include "Solver.cpp"
+
+
+HintEngine::HintEngine(const SolvabilityTables& solvabilityTables)
+	: m_solvabilityTables{ solvabilityTables }, m_thread{ &HintEngine::run, this } {}
+
+HintEngine::~HintEngine() {
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		cancelLocked();
+		m_isShutdown = true;
+	}
+	m_requestAvailable.notify_one();
+	m_thread.join();
+}
+
+std::future<HintResult> HintEngine::request(const LoadedBoard& loadedBoard, uint64_t board) {
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		if (const std::optional<HintResult> hint = cachedHint(loadedBoard, board)) {
+			std::promise<HintResult> promise;
+			promise.set_value(*hint);
+			return promise.get_future();
+		}
+	}
+	return enqueue(loadedBoard, board, false);
+}
+
+void HintEngine::presolve(const LoadedBoard& loadedBoard, uint64_t board) {
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		if (m_solvabilityTables.count(&loadedBoard) != 0 || cachedHint(loadedBoard, board)) {
+			cancelLocked();
+			return;
+		}
+	}
+	enqueue(loadedBoard, board, true);
+}
+
+std::future<HintResult> HintEngine::enqueue(const LoadedBoard& loadedBoard, uint64_t board, bool isSpeculative) {
+	HintRequest request{ &loadedBoard, board, isSpeculative, std::promise<HintResult>() };
+	std::future<HintResult> result = request.promise.get_future();
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		cancelLocked();
+		m_pendingRequest = std::move(request);
+	}
+	m_requestAvailable.notify_one();
+	return result;
+}
+
+void HintEngine::cacheSolution(const LoadedBoard& loadedBoard, uint64_t board, HintResult::Status status, const std::vector<MoveByte>& solutionPath) {
+	if (m_cachedHints.size() + solutionPath.size() >= kMaxCachedHints) {
+		m_cachedHints.clear();
+	}
+	if (solutionPath.empty()) {
+		m_cachedHints.insert_or_assign(CacheKey{ &loadedBoard, board }, CachedHint{ status, MoveByte{ 0, 0, 0 } });
+		return;
+	}
+	// Every suffix of a solution path is a solution of the board it starts at
+	for (const MoveByte& move : solutionPath) {
+		m_cachedHints.insert_or_assign(CacheKey{ &loadedBoard, board }, CachedHint{ HintResult::Status::Found, move });
+		board ^= (1ULL << move.from) | (1ULL << move.over) | (1ULL << move.to);
+	}
+}
+
+std::optional<HintResult> HintEngine::cachedHint(const LoadedBoard& loadedBoard, uint64_t board) const {
+	const auto cached = m_cachedHints.find(CacheKey{ &loadedBoard, board });
+	if (cached == m_cachedHints.end()) {
+		return std::nullopt;
+	}
+	HintResult result;
+	result.status = cached->second.status;
+	result.loadedBoard = &loadedBoard;
+	result.board = board;
+	result.move = cached->second.move;
+	return result;
+}
+
+void HintEngine::cancel() {
+	std::lock_guard<std::mutex> lock(m_mutex);
+	cancelLocked();
+}
+
+void HintEngine::cancelLocked() {
+	if (m_pendingRequest) {
+		HintResult result;
+		result.loadedBoard = m_pendingRequest->loadedBoard;
+		result.board = m_pendingRequest->board;
+		m_pendingRequest->promise.set_value(result);
+		m_pendingRequest.reset();
+	}
+	m_cancelToken.cancel();
+}
+
+void HintEngine::run() {
+	while (true) {
+		HintRequest request;
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+			m_requestAvailable.wait(lock, [this]() { return m_pendingRequest.has_value() || m_isShutdown; });
+			if (m_isShutdown) {
+				return;
+			}
+			request = std::move(*m_pendingRequest);
+			m_pendingRequest.reset();
+			m_cancelToken.reset();
+		}
+		// Speculative searches are capped to one core, so they do not slow down the game
+		request.promise.set_value(computeHint(*request.loadedBoard, request.board, request.isSpeculative ? 1 : 0));
+	}
+}
+
+HintResult HintEngine::computeHint(const LoadedBoard& loadedBoard, uint64_t board, unsigned int threadCount) {
+	HintResult result;
+	result.loadedBoard = &loadedBoard;
+	result.board = board;
+	if (board == loadedBoard.tables.solutionBoard) {
+		result.status = HintResult::Status::AlreadySolved;
+		return result;
+	}
+
+	// A table answers with a few binary searches, the solver is only needed for boards without a (valid) table
+	const auto table = m_solvabilityTables.find(&loadedBoard);
+	if (table != m_solvabilityTables.end()) {
+		try {
+			const std::optional<MoveByte> move = table->second->findWinningMove(board);
+			result.status = move ? HintResult::Status::Found : HintResult::Status::NoSolution;
+			if (move) {
+				result.move = *move;
+			}
+			return result;
+		} catch (const std::runtime_error& error) {
+			std::cout << error.what() << " Falling back to the solver." << std::endl;
+		}
+	}
+
+	// Searches on all cores, the dead boards found by earlier hints of the board are reused.
+	// Boards with more fields than the 33 of the English board get twice the time, e.g. the European board
+	const auto timeLimit = loadedBoard.tables.fieldCount > 33 ? std::chrono::seconds(50) : std::chrono::seconds(25);
+	SearchBudget budget(timeLimit, SearchBudget::kUnlimitedNodes, &m_cancelToken);
+	ParallelSolver<LoadedBoardTraits<uint64_t>> solver(loadedBoard.layout, board, threadCount,
+		&SharedTranspositionTable<uint64_t>::forLayout(loadedBoard.layout));
+	solver.setSearchStrategy(SearchStrategy::OrderedDepthFirst);
+	const SolveResult solveResult = solver.solve(budget);
+	const std::vector<MoveByte> solutionPath(solver.getSolutionPath().begin(), solver.getSolutionPath().end());
+	result.stats = solver.getStats();
+	switch (solveResult.status) {
+	case SolveResult::Status::Solved:
+		result.status = solutionPath.empty() ? HintResult::Status::AlreadySolved : HintResult::Status::Found;
+		if (!solutionPath.empty()) {
+			result.move = solutionPath[0]; // the first move of the solution found
+		}
+		break;
+	case SolveResult::Status::Unsolvable:
+		result.status = HintResult::Status::NoSolution;
+		break;
+	case SolveResult::Status::TimedOut:
+		result.status = HintResult::Status::TimedOut;
+		break;
+	case SolveResult::Status::Cancelled:
+		result.status = HintResult::Status::Cancelled;
+		break;
+	}
+
+	if (result.status == HintResult::Status::Found || result.status == HintResult::Status::NoSolution) {
+		std::lock_guard<std::mutex> lock(m_mutex);
+		cacheSolution(loadedBoard, board, result.status, solutionPath);
+	}
+	return result;
+}
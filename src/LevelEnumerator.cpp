@@ -0,0 +1,166 @@
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <future>
+#include <thread>
+#include <vector>
+#include "LevelEnumerator.h"
+
+
+/**
+	Runs a task on the given number of threads and waits for all of them. Exceptions of a task are rethrown.
+	\param threadCount The number of threads
+	\param task The task, called with the index of its thread
+*/
+template <typename Task>
+static void runParallel(unsigned int threadCount, const Task& task) {
+	std::vector<std::future<void>> workers;
+	for (unsigned int threadIdx = 1; threadIdx < threadCount; ++threadIdx) {
+		workers.push_back(std::async(std::launch::async, task, threadIdx));
+	}
+	task(0);
+	for (std::future<void>& worker : workers) {
+		worker.get();
+	}
+}
+
+/**
+	Sorts the keys and removes duplicates.
+*/
+static void sortUnique(std::vector<uint64_t>& keys, std::vector<uint64_t>& buffer) {
+	LevelEnumerator::radixSort(keys, buffer);
+	keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+}
+
+LevelEnumerator::LevelEnumerator(const BoardLayout& layout, unsigned int threadCount)
+	: m_layout{ layout }, m_threadCount{ threadCount != 0 ? threadCount : std::max(1U, std::thread::hardware_concurrency()) } {}
+
+void LevelEnumerator::radixSort(std::vector<uint64_t>& keys, std::vector<uint64_t>& buffer) {
+	constexpr std::size_t digitBits = 16;
+	constexpr std::size_t digitValues = std::size_t{ 1 } << digitBits;
+	buffer.resize(keys.size());
+	std::vector<std::size_t> offsets(digitValues);
+	for (std::size_t shift = 0; shift < 64; shift += digitBits) {
+		std::fill(offsets.begin(), offsets.end(), 0);
+		for (const uint64_t key : keys) {
+			++offsets[(key >> shift) & (digitValues - 1)];
+		}
+		if (keys.empty() || offsets[(keys.front() >> shift) & (digitValues - 1)] == keys.size()) {
+			continue; // all keys share this digit
+		}
+		std::size_t offset = 0;
+		for (std::size_t& count : offsets) {
+			offset += count;
+			count = offset - count;
+		}
+		for (const uint64_t key : keys) {
+			buffer[offsets[(key >> shift) & (digitValues - 1)]++] = key;
+		}
+		keys.swap(buffer);
+	}
+}
+
+std::vector<uint64_t> LevelEnumerator::expand(const std::vector<uint64_t>& level, Direction direction) {
+	if (level.empty()) {
+		return {};
+	}
+	const std::chrono::time_point<std::chrono::steady_clock> startTime = std::chrono::steady_clock::now();
+	const unsigned int threadCount = m_threadCount;
+	const std::size_t shardCount = 4 * static_cast<std::size_t>(threadCount); // more shards than threads balance the second phase
+	const auto shardOf = [shardCount](uint64_t key) {
+		return static_cast<std::size_t>(((key * 0x9E3779B97F4A7C15ULL) >> 32) % shardCount);
+	};
+
+	// Phase 1: expand a slice of the level per thread and distribute the successors into buckets by hash
+	std::vector<std::vector<std::vector<uint64_t>>> buckets(threadCount, std::vector<std::vector<uint64_t>>(shardCount));
+	std::vector<std::size_t> generatedCounts(threadCount, 0);
+	runParallel(threadCount, [&](unsigned int threadIdx) {
+		std::vector<std::vector<uint64_t>>& threadBuckets = buckets[threadIdx];
+		std::vector<std::size_t> uniqueCounts(shardCount, 0);
+		std::vector<uint64_t> buffer;
+		std::size_t generatedCount = 0;
+		const std::size_t begin = level.size() * threadIdx / threadCount;
+		const std::size_t end = level.size() * (threadIdx + 1) / threadCount;
+		for (std::size_t boardIdx = begin; boardIdx < end; ++boardIdx) {
+			const uint64_t board = level[boardIdx];
+			const JumpSet jumps = direction == Direction::Forward ? m_layout.legalJumps(board) : m_layout.legalReverseJumps(board);
+			for (std::size_t jumpDirection = 0; jumpDirection < jumps.size(); ++jumpDirection) {
+				for (uint64_t origins = jumps[jumpDirection]; origins != 0; origins &= origins - 1) {
+					const MoveByte move = m_layout.gridMove(lowestBitIndex(origins), jumpDirection);
+					const uint64_t successor = board ^ ((1ULL << move.from) | (1ULL << move.over) | (1ULL << move.to));
+					if (direction == Direction::Forward && !std::all_of(m_layout.pagodas.begin(), m_layout.pagodas.end(),
+						[successor](const Pagoda& pagoda) { return pagoda.value(successor) >= pagoda.goalValue; })) {
+						continue;
+					}
+					const uint64_t key = m_layout.canonicalize(successor);
+					const std::size_t shard = shardOf(key);
+					threadBuckets[shard].push_back(key);
+					++generatedCount;
+					// Most successors are reached on several paths, removing them in between bounds the memory of large boards
+					if (threadBuckets[shard].size() > 2 * uniqueCounts[shard] + (1 << 16)) {
+						sortUnique(threadBuckets[shard], buffer);
+						uniqueCounts[shard] = threadBuckets[shard].size();
+					}
+				}
+			}
+		}
+		generatedCounts[threadIdx] = generatedCount;
+	});
+
+	// Phase 2: every shard collects its buckets of all threads and removes the duplicates
+	std::vector<std::vector<uint64_t>> shards(shardCount);
+	runParallel(threadCount, [&](unsigned int threadIdx) {
+		std::vector<uint64_t> buffer;
+		for (std::size_t shard = threadIdx; shard < shardCount; shard += threadCount) {
+			std::size_t shardSize = 0;
+			for (const std::vector<std::vector<uint64_t>>& threadBuckets : buckets) {
+				shardSize += threadBuckets[shard].size();
+			}
+			shards[shard].reserve(shardSize);
+			for (std::vector<std::vector<uint64_t>>& threadBuckets : buckets) {
+				shards[shard].insert(shards[shard].end(), threadBuckets[shard].begin(), threadBuckets[shard].end());
+				threadBuckets[shard] = std::vector<uint64_t>();
+			}
+			sortUnique(shards[shard], buffer);
+		}
+	});
+
+	// Phase 3: the shards are disjoint, so splitting the key range at quantiles of the largest shard
+	// lets every thread merge one range of all shards into its place of the result
+	const std::vector<uint64_t>& largestShard = *std::max_element(shards.begin(), shards.end(),
+		[](const std::vector<uint64_t>& lhs, const std::vector<uint64_t>& rhs) { return lhs.size() < rhs.size(); });
+	std::vector<std::vector<std::size_t>> bounds(shardCount, std::vector<std::size_t>(threadCount + 1));
+	std::vector<std::size_t> rangeOffsets(threadCount + 1, 0);
+	for (std::size_t shard = 0; shard < shardCount; ++shard) {
+		for (unsigned int range = 1; range < threadCount; ++range) {
+			const uint64_t splitter = largestShard.empty() ? 0 : largestShard[largestShard.size() * range / threadCount];
+			bounds[shard][range] = static_cast<std::size_t>(
+				std::lower_bound(shards[shard].begin(), shards[shard].end(), splitter) - shards[shard].begin());
+		}
+		bounds[shard][threadCount] = shards[shard].size();
+		for (unsigned int range = 1; range <= threadCount; ++range) {
+			rangeOffsets[range] += bounds[shard][range];
+		}
+	}
+	std::vector<uint64_t> nextLevel(rangeOffsets[threadCount]);
+	runParallel(threadCount, [&](unsigned int range) {
+		auto output = nextLevel.begin() + static_cast<std::ptrdiff_t>(rangeOffsets[range]);
+		for (std::size_t shard = 0; shard < shardCount; ++shard) {
+			const auto shardBegin = shards[shard].begin();
+			output = std::copy(shardBegin + static_cast<std::ptrdiff_t>(bounds[shard][range]),
+				shardBegin + static_cast<std::ptrdiff_t>(bounds[shard][range + 1]), output);
+		}
+		std::sort(nextLevel.begin() + static_cast<std::ptrdiff_t>(rangeOffsets[range]), output);
+	});
+
+	LevelStats stats;
+	stats.pegs = pegCount(level.front());
+	stats.states = level.size();
+	for (const std::size_t count : generatedCounts) {
+		stats.generatedStates += count;
+	}
+	stats.uniqueStates = nextLevel.size();
+	stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+	m_stats.push_back(stats);
+	return nextLevel;
+}
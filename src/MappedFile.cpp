@@ -0,0 +1,103 @@
+#include <stdexcept>
+#include <utility>
+#include "MappedFile.h"
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+
+MappedFile::MappedFile(const std::string& path) {
+#if defined(_WIN32)
+	m_fileHandle = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (m_fileHandle == INVALID_HANDLE_VALUE) {
+		m_fileHandle = nullptr;
+		throw std::runtime_error("Failed to open " + path + ".");
+	}
+	LARGE_INTEGER fileSize;
+	if (!GetFileSizeEx(m_fileHandle, &fileSize) || fileSize.QuadPart == 0) {
+		close();
+		throw std::runtime_error("Failed to read the size of " + path + ".");
+	}
+	m_size = static_cast<std::size_t>(fileSize.QuadPart);
+	m_mappingHandle = CreateFileMappingA(m_fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	const void* view = m_mappingHandle ? MapViewOfFile(m_mappingHandle, FILE_MAP_READ, 0, 0, 0) : nullptr;
+	if (view == nullptr) {
+		close();
+		throw std::runtime_error("Failed to map " + path + " into memory.");
+	}
+	m_data = static_cast<const std::byte*>(view);
+#else
+	m_fileDescriptor = ::open(path.c_str(), O_RDONLY);
+	if (m_fileDescriptor < 0) {
+		throw std::runtime_error("Failed to open " + path + ".");
+	}
+	struct stat fileStatus;
+	if (::fstat(m_fileDescriptor, &fileStatus) != 0 || fileStatus.st_size == 0) {
+		close();
+		throw std::runtime_error("Failed to read the size of " + path + ".");
+	}
+	m_size = static_cast<std::size_t>(fileStatus.st_size);
+	void* view = ::mmap(nullptr, m_size, PROT_READ, MAP_SHARED, m_fileDescriptor, 0);
+	if (view == MAP_FAILED) {
+		close();
+		throw std::runtime_error("Failed to map " + path + " into memory.");
+	}
+	m_data = static_cast<const std::byte*>(view);
+#endif
+}
+
+MappedFile::~MappedFile() {
+	close();
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept {
+	*this = std::move(other);
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+	if (this != &other) {
+		close();
+		std::swap(m_data, other.m_data);
+		std::swap(m_size, other.m_size);
+#if defined(_WIN32)
+		std::swap(m_fileHandle, other.m_fileHandle);
+		std::swap(m_mappingHandle, other.m_mappingHandle);
+#else
+		std::swap(m_fileDescriptor, other.m_fileDescriptor);
+#endif
+	}
+	return *this;
+}
+
+void MappedFile::close() {
+#if defined(_WIN32)
+	if (m_data != nullptr) {
+		UnmapViewOfFile(m_data);
+	}
+	if (m_mappingHandle != nullptr) {
+		CloseHandle(m_mappingHandle);
+	}
+	if (m_fileHandle != nullptr) {
+		CloseHandle(m_fileHandle);
+	}
+	m_fileHandle = nullptr;
+	m_mappingHandle = nullptr;
+#else
+	if (m_data != nullptr) {
+		::munmap(const_cast<std::byte*>(m_data), m_size);
+	}
+	if (m_fileDescriptor >= 0) {
+		::close(m_fileDescriptor);
+	}
+	m_fileDescriptor = -1;
+#endif
+	m_data = nullptr;
+	m_size = 0;
+}
@@ -0,0 +1,194 @@
+#include <algorithm>
+#include <iterator>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <cstring>
+#include <cstddef>
+#include <string>
+#include "SolvabilityTable.h"
+
+
+/**
+	Gets the grid bitboard after a move (in grid bits).
+*/
+static uint64_t applyGridMove(uint64_t board, const MoveByte& move) {
+	return board ^ ((1ULL << move.from) | (1ULL << move.over) | (1ULL << move.to));
+}
+
+/**
+	Checks whether none of the pagoda functions of the layout proves a grid bitboard unsolvable.
+*/
+static bool passesPagodas(const BoardLayout& layout, uint64_t board) {
+	return std::all_of(layout.pagodas.begin(), layout.pagodas.end(), [board](const Pagoda& pagoda) {
+		return pagoda.value(board) >= pagoda.goalValue;
+	});
+}
+
+SolvabilityTable::Levels SolvabilityTable::enumerateReachable(LevelEnumerator& enumerator, uint64_t startBoard) {
+	const BoardLayout& layout = enumerator.getLayout();
+	const uint64_t start = layout.canonicalize(layout.toGridBoard(startBoard));
+	Levels reachable;
+	if (layout.positionClass(start) != layout.positionClass(layout.solutionBoard) || !passesPagodas(layout, start)) {
+		return reachable;
+	}
+
+	// Every move removes one peg, so the successors of a level form the next lower level
+	const unsigned int startPegs = pegCount(start);
+	reachable[startPegs].push_back(start);
+	for (unsigned int pegs = startPegs; pegs > 1; --pegs) {
+		reachable[pegs - 1] = enumerator.expand(reachable[pegs], LevelEnumerator::Direction::Forward);
+	}
+	return reachable;
+}
+
+SolvabilityTable::Levels SolvabilityTable::enumerateWinnable(LevelEnumerator& enumerator, uint64_t startBoard) {
+	const BoardLayout& layout = enumerator.getLayout();
+	Levels reachable = enumerateReachable(enumerator, startBoard);
+	Levels winnable;
+	const unsigned int goalPegs = pegCount(layout.solutionBoard);
+	if (!std::binary_search(reachable[goalPegs].begin(), reachable[goalPegs].end(), layout.solutionBoard)) {
+		return winnable;
+	}
+	winnable[goalPegs].push_back(layout.solutionBoard);
+
+	for (unsigned int pegs = goalPegs + 1; pegs < kLevelCount && !winnable[pegs - 1].empty(); ++pegs) {
+		const std::vector<uint64_t> predecessors = enumerator.expand(winnable[pegs - 1], LevelEnumerator::Direction::Backward);
+		std::set_intersection(predecessors.begin(), predecessors.end(), reachable[pegs].begin(), reachable[pegs].end(),
+			std::back_inserter(winnable[pegs]));
+		reachable[pegs] = std::vector<uint64_t>(); // release the memory of the level early
+	}
+	return winnable;
+}
+
+uint64_t SolvabilityTable::checksum(const std::byte* data, std::size_t size) {
+	uint64_t hash = 0xCBF29CE484222325ULL;
+	for (std::size_t offset = 0; offset + sizeof(uint64_t) <= size; offset += sizeof(uint64_t)) {
+		uint64_t word;
+		std::memcpy(&word, data + offset, sizeof(word));
+		hash = (hash ^ word) * 0x100000001B3ULL;
+	}
+	return hash;
+}
+
+std::string SolvabilityTable::defaultPath(const std::string& boardPath) {
+	return (std::filesystem::path("assets/tables") / std::filesystem::path(boardPath).stem()).string() + ".pst";
+}
+
+void SolvabilityTable::write(const std::string& path, const LoadedBoard& board, uint64_t startBoard, const Levels& levels) {
+	const std::filesystem::path filePath(path);
+	if (filePath.has_parent_path()) {
+		std::filesystem::create_directories(filePath.parent_path());
+	}
+	std::ofstream file(filePath, std::ios::binary | std::ios::trunc);
+	if (!file) {
+		throw std::runtime_error("Failed to create " + path + ".");
+	}
+
+	const BoardLayout& layout = board.layout;
+	FileHeader header;
+	header.cols = static_cast<uint32_t>(layout.cols);
+	header.fieldCount = pegCount(layout.fields);
+	header.symmetryGroup = layout.symmetryGroup;
+	header.fields = layout.fields;
+	header.solutionBoard = layout.solutionBoard;
+	header.startBoard = startBoard;
+	const auto alignToPage = [](uint64_t offset) {
+		return (offset + kPageSize - 1) / kPageSize * kPageSize;
+	};
+	uint64_t offset = alignToPage(sizeof(header));
+	for (std::size_t pegs = 0; pegs < kLevelCount; ++pegs) {
+		const std::vector<uint64_t>& keys = levels[pegs];
+		header.levels[pegs].offset = offset;
+		header.levels[pegs].size = keys.size();
+		header.levels[pegs].checksum = checksum(reinterpret_cast<const std::byte*>(keys.data()), keys.size() * sizeof(uint64_t));
+		offset = alignToPage(offset + keys.size() * sizeof(uint64_t));
+	}
+	header.headerChecksum = checksum(reinterpret_cast<const std::byte*>(&header), offsetof(FileHeader, headerChecksum));
+
+	file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+	for (std::size_t pegs = 0; pegs < kLevelCount; ++pegs) {
+		const std::vector<uint64_t>& keys = levels[pegs];
+		const std::vector<char> padding(static_cast<std::size_t>(header.levels[pegs].offset - static_cast<uint64_t>(file.tellp())), 0);
+		file.write(padding.data(), static_cast<std::streamsize>(padding.size()));
+		file.write(reinterpret_cast<const char*>(keys.data()), static_cast<std::streamsize>(keys.size() * sizeof(uint64_t)));
+	}
+	if (!file) {
+		throw std::runtime_error("Failed to write " + path + ".");
+	}
+}
+
+SolvabilityTable::SolvabilityTable(const std::string& path, const LoadedBoard& board)
+	: m_file{ path }, m_layout{ board.layout } {
+	if (m_file.size() < sizeof(m_header)) {
+		throw std::runtime_error(path + " is no solvability table.");
+	}
+	std::memcpy(&m_header, m_file.data(), sizeof(m_header));
+	if (m_header.magic != FileHeader{}.magic || m_header.version != kVersion) {
+		throw std::runtime_error(path + " is no solvability table of version " + std::to_string(kVersion) + ".");
+	}
+	if (m_header.headerChecksum != checksum(m_file.data(), offsetof(FileHeader, headerChecksum))) {
+		throw std::runtime_error("The header of " + path + " is corrupt.");
+	}
+	if (m_header.cols != m_layout.cols || m_header.fieldCount != pegCount(m_layout.fields) || m_header.fields != m_layout.fields
+		|| m_header.solutionBoard != m_layout.solutionBoard || m_header.symmetryGroup != m_layout.symmetryGroup) {
+		throw std::runtime_error(path + " was generated for another board.");
+	}
+	if (m_header.startBoard != board.tables.startBoard) {
+		throw std::runtime_error(path + " was generated for another start board.");
+	}
+	for (const LevelEntry& level : m_header.levels) {
+		if (level.offset % sizeof(uint64_t) != 0 || level.offset > m_file.size()
+			|| level.size > (m_file.size() - level.offset) / sizeof(uint64_t)) {
+			throw std::runtime_error(path + " is truncated.");
+		}
+	}
+}
+
+const uint64_t* SolvabilityTable::levelKeys(unsigned int pegs) const {
+	const LevelEntry& level = m_header.levels[pegs];
+	const std::byte* data = m_file.data() + level.offset;
+	if (m_levelStates[pegs].load(std::memory_order_acquire) == LevelState::Unchecked) {
+		const bool isValid = checksum(data, level.size * sizeof(uint64_t)) == level.checksum;
+		m_levelStates[pegs].store(isValid ? LevelState::Valid : LevelState::Corrupt, std::memory_order_release);
+	}
+	if (m_levelStates[pegs].load(std::memory_order_acquire) == LevelState::Corrupt) {
+		throw std::runtime_error("The solvability table is corrupt for boards with " + std::to_string(pegs) + " pegs.");
+	}
+	return reinterpret_cast<const uint64_t*>(data);
+}
+
+bool SolvabilityTable::isWinnable(uint64_t gridBoard) const {
+	const unsigned int pegs = pegCount(gridBoard);
+	const uint64_t* keys = levelKeys(pegs);
+	return std::binary_search(keys, keys + m_header.levels[pegs].size, m_layout.canonicalize(gridBoard));
+}
+
+std::vector<MoveByte> SolvabilityTable::findWinningMoves(uint64_t board) const {
+	const uint64_t gridBoard = m_layout.toGridBoard(board);
+	const JumpSet jumps = m_layout.legalJumps(gridBoard);
+	std::vector<MoveByte> moves;
+	for (std::size_t direction = 0; direction < jumps.size(); ++direction) {
+		for (uint64_t origins = jumps[direction]; origins != 0; origins &= origins - 1) {
+			const MoveByte move = m_layout.gridMove(lowestBitIndex(origins), direction);
+			if (isWinnable(applyGridMove(gridBoard, move))) {
+				moves.push_back(m_layout.toBitIdxMove(move));
+			}
+		}
+	}
+	return moves;
+}
+
+std::optional<MoveByte> SolvabilityTable::findWinningMove(uint64_t board) const {
+	const uint64_t gridBoard = m_layout.toGridBoard(board);
+	const JumpSet jumps = m_layout.legalJumps(gridBoard);
+	for (std::size_t direction = 0; direction < jumps.size(); ++direction) {
+		for (uint64_t origins = jumps[direction]; origins != 0; origins &= origins - 1) {
+			const MoveByte move = m_layout.gridMove(lowestBitIndex(origins), direction);
+			if (isWinnable(applyGridMove(gridBoard, move))) {
+				return m_layout.toBitIdxMove(move);
+			}
+		}
+	}
+	return std::nullopt;
+}
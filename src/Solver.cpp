@@ -1,276 +1,1219 @@
-#include <unordered_set>
 #include <vector>
 #include <array>
-#include <chrono>
-#include <iostream>
+#include <memory_resource>
+#include <cstddef>
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <memory>
+#include <stdexcept>
 #include "Move.h"
+#include "GameLogic.h"
+#include "BoardLayout.h"
+#include "SolverStats.h"
+#include "SearchBudget.h"
+#include "MoveOrdering.h"
+#include "BoardTables.h"
+#include "BoardTraits.h"
 
 
+/**
+    Memory resource which forwards to the heap and counts every allocation made through it.
+*/
+class CountingMemoryResource : public std::pmr::memory_resource {
+private:
+    uint64_t m_allocationCount{ 0 };
+
+public:
+    uint64_t getAllocationCount() const {
+        return m_allocationCount;
+    }
+
+private:
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+        ++m_allocationCount;
+        return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override {
+        std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+};
+
+
+inline constexpr std::size_t kDefaultTableBytes = 64 * 1024 * 1024; // default memory budget of a transposition table
+
+
+/**
+    Fixed-capacity transposition table of visited (i.e. dead or currently searched) boards with open addressing.
+    The slots are grouped into buckets of one cache line each, a board is hashed to one bucket and only this bucket is probed,
+    so every lookup is a single cache miss. When a bucket is full, the board with the fewest pegs is replaced,
+    because it roots the smallest subtree and is the cheapest one to search again.
+    Losing an entry never makes the search wrong, it only costs the repeated search of that board.
+    \tparam Key The bitboard type of the boards
+*/
+template <typename Key>
+class TranspositionTable {
+private:
+    static constexpr std::size_t kSlotsPerBucket = 64 / sizeof(Key);
+    static constexpr Key kEmptySlot{}; // the empty board never occurs in a search
+
+    struct alignas(64) Bucket {
+        std::array<Key, kSlotsPerBucket> keys{};
+    };
+
+    std::pmr::vector<Bucket> m_buckets;
+    unsigned int m_hashShift{ 63 }; // 64 - log2(number of buckets)
+    uint64_t m_entries{ 0 };
+    uint64_t m_collisions{ 0 };
+    uint64_t m_replacements{ 0 };
+
+public:
+    /**
+        Creates the table with the largest power-of-two number of buckets fitting into the memory budget.
+        \param bytes The memory budget of the table (at least two buckets are created)
+        \param memoryResource The memory resource the table is allocated from
+    */
+    TranspositionTable(std::size_t bytes, std::pmr::memory_resource* memoryResource) : m_buckets{ memoryResource } {
+        std::size_t bucketCount = 2;
+        while (bucketCount * 2 * sizeof(Bucket) <= bytes) {
+            bucketCount *= 2;
+            --m_hashShift;
+        }
+        m_buckets.resize(bucketCount);
+    }
+
+    /**
+        Removes all boards from the table and resets its statistics.
+    */
+    void clear() {
+        std::fill(m_buckets.begin(), m_buckets.end(), Bucket{});
+        m_entries = 0;
+        m_collisions = 0;
+        m_replacements = 0;
+    }
+
+    /**
+        Inserts a board into the table.
+        \param key The (canonical) board
+        \return True if the board was not contained in the table before, false otherwise
+    */
+    bool insert(const Key& key) {
+        Bucket& bucket = m_buckets[bitboardHash(key) >> m_hashShift]; // Fibonacci hashing
+        std::size_t replacedSlot = 0;
+        for (std::size_t slot = 0; slot < kSlotsPerBucket; ++slot) {
+            if (bucket.keys[slot] == key) {
+                return false;
+            }
+            if (bucket.keys[slot] == kEmptySlot) {
+                if (slot > 0) {
+                    ++m_collisions;
+                }
+                bucket.keys[slot] = key;
+                ++m_entries;
+                return true;
+            }
+            if (pegCount(bucket.keys[slot]) < pegCount(bucket.keys[replacedSlot])) {
+                replacedSlot = slot;
+            }
+        }
+        ++m_collisions;
+        ++m_replacements;
+        bucket.keys[replacedSlot] = key;
+        return true;
+    }
+
+    uint64_t capacity() const {
+        return m_buckets.size() * kSlotsPerBucket;
+    }
+
+    uint64_t entries() const {
+        return m_entries;
+    }
+
+    uint64_t collisions() const {
+        return m_collisions;
+    }
+
+    uint64_t replacements() const {
+        return m_replacements;
+    }
+};
+
+
+/**
+    Lock-free transposition table which any number of searches of the same board layout can share, also at the same time.
+    Each slot holds a value (state, peg count and search id) and the check word key ^ value. The two words are written
+    with separate atomic operations, so a reader validates a slot by (check ^ value) == key: a slot torn by concurrent
+    writers never validates and simply counts as empty ("lockless hashing"). Writers claim a slot by compare-and-swap on its value.
+    A board is stored in one of two states:
+    - Dead: its whole subtree was searched without reaching the goal. This holds for every search of the layout,
+      so every later search profits from it.
+    - Searching: it is searched right now by the search with the stored id. Other threads of the same search skip it,
+      other searches ignore the entry, as the board may still be solvable.
+    Boards of several words keep one check word per word of the board, a slot only validates if all of them match.
+    \tparam Key The bitboard type of the boards
+*/
+template <typename Key>
+class SharedTranspositionTable {
+public:
+    /**
+        Outcome of claiming a board for a search.
+    */
+    enum class ClaimResult {
+        Claimed, // the board has to be searched by the caller
+        Dead, // the board is known to be unsolvable
+        Busy, // another thread of the same search is searching the board
+    };
+
+    /**
+        Counters of the probes of one thread, kept by the caller to avoid contention on shared counters.
+    */
+    struct Counters {
+        uint64_t collisions{ 0 }; // number of boards stored outside the first slot of their bucket
+        uint64_t replacements{ 0 }; // number of boards evicted from the table because their bucket was full
+    };
+
+private:
+    static constexpr std::size_t kKeyWords = kBitboardWords<Key>;
+    static constexpr uint64_t kDead = 1;
+    static constexpr uint64_t kSearching = 2;
+
+    struct Slot {
+        std::array<std::atomic<uint64_t>, kKeyWords> check{}; // key ^ value (word by word)
+        std::atomic<uint64_t> value{ 0 }; // search id << 32 | peg count << 8 | state, never 0 for an occupied slot
+    };
+
+    static constexpr std::size_t kSlotsPerBucket = 64 / sizeof(Slot) > 0 ? 64 / sizeof(Slot) : 1;
+
+    struct alignas(64) Bucket {
+        std::array<Slot, kSlotsPerBucket> slots{};
+    };
+
+    std::vector<Bucket> m_buckets;
+    unsigned int m_hashShift{ 63 }; // 64 - log2(number of buckets)
+    std::atomic<uint32_t> m_nextSearchId{ 1 };
+    std::atomic<uint64_t> m_entries{ 0 }; // only changes when an empty slot is taken, which happens at most once per slot
+
+    static uint64_t makeValue(const Key& key, uint64_t state, uint32_t searchId) {
+        return (static_cast<uint64_t>(searchId) << 32) | (static_cast<uint64_t>(pegCount(key)) << 8) | state;
+    }
+
+    Bucket& bucketOf(const Key& key) {
+        return m_buckets[bitboardHash(key) >> m_hashShift]; // Fibonacci hashing
+    }
+
+    /**
+        Checks whether an occupied slot, whose value was loaded before, holds the given board.
+    */
+    static bool holds(const Slot& slot, uint64_t value, const Key& key) {
+        uint64_t difference = 0;
+        for (std::size_t wordIdx = 0; wordIdx < kKeyWords; ++wordIdx) {
+            difference |= slot.check[wordIdx].load(std::memory_order_relaxed) ^ value ^ bitboardWord(key, wordIdx);
+        }
+        return difference == 0;
+    }
+
+    /**
+        Stores a value for a board, either in the slot already holding the board or in the least valuable slot of the bucket:
+        an empty slot, else an entry of a finished search, else the board with the fewest pegs (the smallest subtree).
+        Losing the race for a slot to another writer just leaves the board unstored.
+    */
+    void store(Bucket& bucket, const Key& key, uint64_t value, uint32_t searchId, Counters& counters) {
+        std::size_t targetSlot = 0;
+        uint64_t targetValue = 0;
+        unsigned int targetScore = ~0U;
+        for (std::size_t slot = 0; slot < kSlotsPerBucket; ++slot) {
+            const uint64_t storedValue = bucket.slots[slot].value.load(std::memory_order_relaxed);
+            unsigned int score;
+            if (storedValue != 0 && holds(bucket.slots[slot], storedValue, key)) {
+                score = 0; // the board itself
+            } else if (storedValue == 0) {
+                score = 1;
+            } else if ((storedValue & 0xFF) == kSearching && (storedValue >> 32) != searchId) {
+                score = 2;
+            } else {
+                score = 3 + static_cast<unsigned int>((storedValue >> 8) & 0xFF);
+            }
+            if (score < targetScore) {
+                targetSlot = slot;
+                targetValue = storedValue;
+                targetScore = score;
+            }
+        }
+
+        Slot& slot = bucket.slots[targetSlot];
+        if (!slot.value.compare_exchange_strong(targetValue, value, std::memory_order_relaxed)) {
+            return;
+        }
+        for (std::size_t wordIdx = 0; wordIdx < kKeyWords; ++wordIdx) {
+            slot.check[wordIdx].store(bitboardWord(key, wordIdx) ^ value, std::memory_order_relaxed);
+        }
+        if (targetScore == 0) {
+            return;
+        }
+        if (targetSlot > 0) {
+            ++counters.collisions;
+        }
+        if (targetScore == 1) {
+            m_entries.fetch_add(1, std::memory_order_relaxed);
+        } else {
+            ++counters.replacements;
+        }
+    }
+
+public:
+    /**
+        Creates the table with the largest power-of-two number of buckets fitting into the memory budget.
+        \param bytes The memory budget of the table (at least two buckets are created)
+    */
+    explicit SharedTranspositionTable(std::size_t bytes) {
+        std::size_t bucketCount = 2;
+        while (bucketCount * 2 * sizeof(Bucket) <= bytes) {
+            bucketCount *= 2;
+            --m_hashShift;
+        }
+        m_buckets = std::vector<Bucket>(bucketCount);
+    }
+
+    /**
+        Gets the table shared by all searches of a board in the process, created on first use.
+        \param layout The layout of the board, which identifies the board and has to live as long as its searches
+    */
+    static SharedTranspositionTable& forLayout(const BasicBoardLayout<Key>& layout);
+
+    /**
+        Starts a new search, whose boards in state Searching are only visible to itself.
+        \return The id of the search
+    */
+    uint32_t beginSearch() {
+        return m_nextSearchId.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    /**
+        Claims a board for a search, unless it is known to be dead or another thread of the search is searching it.
+        \param key The (canonical) board
+        \param searchId The id of the search
+        \param counters The counters of the calling thread
+    */
+    ClaimResult claim(const Key& key, uint32_t searchId, Counters& counters) {
+        Bucket& bucket = bucketOf(key);
+        for (Slot& slot : bucket.slots) {
+            const uint64_t value = slot.value.load(std::memory_order_relaxed);
+            if (value != 0 && holds(slot, value, key)) {
+                if ((value & 0xFF) == kDead) {
+                    return ClaimResult::Dead;
+                }
+                if ((value >> 32) == searchId) {
+                    return ClaimResult::Busy;
+                }
+                break; // left over by another search, the board is claimed again below
+            }
+        }
+        store(bucket, key, makeValue(key, kSearching, searchId), searchId, counters);
+        return ClaimResult::Claimed;
+    }
+
+    /**
+        Marks a board as dead after its whole subtree was searched without a solution.
+        \param key The (canonical) board
+        \param searchId The id of the search
+        \param counters The counters of the calling thread
+    */
+    void markDead(const Key& key, uint32_t searchId, Counters& counters) {
+        store(bucketOf(key), key, makeValue(key, kDead, 0), searchId, counters);
+    }
+
+    uint64_t capacity() const {
+        return m_buckets.size() * kSlotsPerBucket;
+    }
+
+    uint64_t entries() const {
+        return m_entries.load(std::memory_order_relaxed);
+    }
+};
+
+
+/**
+    One level of the explicit search stack: the jumps of a board that are not yet tried and the jump tried last.
+    Without move ordering the remaining jumps are taken from the jump set, otherwise from the sorted moves of the level.
+*/
+template <typename Board>
+struct SearchFrame {
+    BasicJumpSet<Board> remainingJumps{};
+    std::size_t direction{ 0 };
+    uint16_t nextMove{ 0 }; // index of the next of the sorted moves
+    uint16_t moveCount{ 0 }; // number of sorted moves
+    MoveByte move{ 0, 0, 0 }; // the move (in grid bits) leading from this level to the next one
+    bool complete{ true }; // false if a board below was skipped because another thread searches it, so this board is not proven dead
+};
+
+
+/**
+    Board of a level of the beam search, linked to the board of the previous level it was reached from.
+*/
+template <typename Board>
+struct BeamNode {
+    Board board; // grid bitboard
+    Board key; // canonical board
+    int score;
+    uint32_t parent; // index in the previous level
+    MoveByte move; // move (in grid bits) leading from the parent to the board
+};
+
+
+/**
+    Depth-first (or beam) search for a solution of a board, instantiated for every board by its traits (see BoardTraits.h).
+    The move generation, the goal test and the symmetry reduction only use constants of the traits,
+    so the compiler inlines them into the search loop with the shifts, masks and loop bounds of the board.
+    Boards loaded from a file (LoadedBoardTraits) read these values from their layout instead.
+*/
+template <typename BoardTraits>
 class Solver {
+public:
+    using Bounds = BoardTraitsBounds<BoardTraits>;
+    using Board = typename Bounds::Board; // bitboard type of the board, uint64_t for grids of up to 64 fields
+    using Layout = BasicBoardLayout<Board>;
+    using JumpSet = BasicJumpSet<Board>;
+    static constexpr std::size_t kMaxDepth = Bounds::kMaxDepth; // a board of n fields is solved after at most n - 1 moves
+    static constexpr std::size_t kMaxMoves = Bounds::kMaxMoves; // upper bound of the legal moves of a board (all jumps of the board)
+    static constexpr std::size_t kDefaultBeamWidth = 4096; // boards kept per level by the beam search
+
 protected:
-    uint64_t m_board;
+    const Layout& m_layout; // layout of the board which is solved
+    Board m_board; // current board as grid bitboard
+    SolverStats m_stats{};
 private:
-    std::unordered_set<uint64_t> m_visitedBoardStates{}; // tracks visited board states
-    std::vector<MoveByte> m_solutionPath{}; // stores the moves of the found solution path
+    CountingMemoryResource m_heap{}; // every buffer of the search is allocated from it on construction, the search itself does not touch the heap
+    TranspositionTable<Board> m_visitedBoardStates; // tracks visited board states (in canonical form)
+    std::array<SearchFrame<Board>, kMaxDepth> m_moveStack{}; // explicit stack of the depth-first search
+    std::pmr::vector<int> m_pagodaValues; // current value of every pagoda function of the layout
+    std::pmr::vector<MoveByte> m_solutionPath{ &m_heap }; // stores the moves of the found solution path (capacity reserved on construction)
+    SharedTranspositionTable<Board>* m_sharedVisitedBoardStates{ nullptr }; // replaces the own table if set
+    typename SharedTranspositionTable<Board>::Counters m_sharedTableCounters{};
+    uint32_t m_searchId{ 0 }; // id of the current search in the shared table
+    std::atomic<bool>* m_stopFlag{ nullptr }; // set by any search of a ParallelSolver to stop all of them
+    SearchBudget* m_budget{ nullptr }; // limits of the current search
+    uint64_t m_chargedNodes{ 0 }; // explored nodes already charged to the budget
+    SearchStrategy m_searchStrategy{ SearchStrategy::DepthFirst };
+    std::size_t m_beamWidth{ kDefaultBeamWidth };
+    BasicMoveOrdering<Board> m_moveOrdering;
+    std::pmr::vector<MoveByte> m_orderedMoves{ &m_heap }; // kMaxMoves sorted moves per level of the move stack, only allocated with move ordering
+    std::array<int, kMaxMoves> m_moveScores{}; // scores of the moves being sorted
+    std::pmr::vector<BeamNode<Board>> m_beamNodes{ &m_heap }; // boards of all levels of the beam search, only reserved with the beam search
+    std::array<std::size_t, kMaxDepth + 2> m_beamLevelStarts{}; // level k of the beam holds the nodes m_beamLevelStarts[k] to m_beamLevelStarts[k + 1]
+    std::pmr::vector<BeamNode<Board>> m_beamSuccessors{ &m_heap }; // successors of the current level of the beam search
 
 public:
-    Solver(uint64_t board) : m_board{ board } {};
+    /**
+        Creates the solver of a board, which starts with the default search strategy of the board traits.
+        \param board The board to solve in compact format
+        \param tableBytes The memory budget of the own transposition table
+    */
+    Solver(const Board& board, std::size_t tableBytes = kDefaultTableBytes)
+        : Solver(BoardTraits::layout(), board, tableBytes) {
+    };
+
+    /**
+        Creates the solver of a board with the given layout, which is needed for boards loaded from a file (see BoardDefinition.h).
+        \param layout The layout of the board, which has to outlive the solver
+        \param board The board to solve in compact format
+        \param tableBytes The memory budget of the own transposition table
+    */
+    Solver(const Layout& layout, const Board& board, std::size_t tableBytes = kDefaultTableBytes)
+        : Solver(layout, board, tableBytes, BoardTraits::kDefaultSearchStrategy) {
+    };
     ~Solver() = default;
 
-    bool solve(const std::chrono::time_point<std::chrono::system_clock>& startTime, std::chrono::milliseconds& timeout) {
-        m_visitedBoardStates.clear();
+    /**
+        Selects how the next searches explore the board.
+        \param strategy The search strategy
+        \param beamWidth The number of boards kept per level by the beam search
+    */
+    void setSearchStrategy(SearchStrategy strategy, std::size_t beamWidth = kDefaultBeamWidth) {
+        m_searchStrategy = strategy;
+        m_beamWidth = beamWidth;
+        if (strategy != SearchStrategy::DepthFirst) {
+            m_orderedMoves.resize(kMaxDepth * kMaxMoves, MoveByte(0, 0, 0));
+        }
+        if (strategy == SearchStrategy::Beam) {
+            // Every move removes a peg, so there are at most kMaxDepth levels after the initial board,
+            // and every board of a level has at most one successor per jump of the board
+            std::size_t jumpCount = 0;
+            for (const Board& origins : m_layout.jumpOrigins) {
+                jumpCount += pegCount(origins);
+            }
+            m_beamNodes.reserve(1 + kMaxDepth * m_beamWidth);
+            m_beamSuccessors.reserve(m_beamWidth * jumpCount);
+        } else {
+            m_beamNodes = std::pmr::vector<BeamNode<Board>>(&m_heap);
+            m_beamSuccessors = std::pmr::vector<BeamNode<Board>>(&m_heap);
+        }
+    }
+
+    /**
+        Searches a solution of the board within the limits of a budget.
+        \param budget The limits of the search, checked every SearchBudget::kCheckInterval explored nodes
+        \return Whether a solution was found, the search was completed without one or stopped by a limit
+    */
+    SolveResult solve(SearchBudget& budget) {
         m_solutionPath.clear();
-        return backtrack(startTime, timeout);
+        m_stats = SolverStats{};
+        m_budget = &budget;
+        m_chargedNodes = 0;
+        const uint64_t heapAllocationsBefore = m_heap.getAllocationCount();
+        if (!budget.charge(0)) {
+            return SolveResult{ budget.stopStatus(), 0 };
+        }
+
+        // Moves never change the position class, so a board of another class than the goal needs no search at all
+        if (m_layout.positionClass(m_board) != m_layout.positionClass(m_layout.solutionBoard)) {
+            ++m_stats.positionClassRejections;
+            return SolveResult{ SolveResult::Status::Unsolvable, 0 };
+        }
+
+        if (m_sharedVisitedBoardStates) {
+            m_searchId = m_sharedVisitedBoardStates->beginSearch();
+            m_sharedTableCounters = typename SharedTranspositionTable<Board>::Counters{};
+        } else {
+            m_visitedBoardStates.clear();
+        }
+        for (std::size_t pagodaIdx = 0; pagodaIdx < m_pagodaValues.size(); ++pagodaIdx) {
+            m_pagodaValues[pagodaIdx] = m_layout.pagodas[pagodaIdx].value(m_board);
+        }
+
+        // The beam search is incomplete, so unless it was stopped by the budget the depth-first search decides its failures
+        bool solved = m_searchStrategy == SearchStrategy::Beam && beamSearch();
+        if (!solved && budget.stopStatus() == SolveResult::Status::Unsolvable) {
+            solved = backtrack();
+        }
+        m_stats.heapAllocations = m_heap.getAllocationCount() - heapAllocationsBefore;
+        if (m_sharedVisitedBoardStates) {
+            m_stats.tableCapacity = m_sharedVisitedBoardStates->capacity();
+            m_stats.tableEntries = m_sharedVisitedBoardStates->entries();
+            m_stats.tableCollisions = m_sharedTableCounters.collisions;
+            m_stats.tableReplacements = m_sharedTableCounters.replacements;
+        } else {
+            m_stats.tableCapacity = m_visitedBoardStates.capacity();
+            m_stats.tableEntries = m_visitedBoardStates.entries();
+            m_stats.tableCollisions = m_visitedBoardStates.collisions();
+            m_stats.tableReplacements = m_visitedBoardStates.replacements();
+        }
+        return SolveResult{ solved ? SolveResult::Status::Solved : budget.stopStatus(), m_stats.nodesExplored };
     }
 
-    std::vector<MoveByte>& getSolutionPath() {
+    /**
+        Gets the moves of the found solution path in the compact bit indices of GameLogic.
+    */
+    std::pmr::vector<MoveByte>& getSolutionPath() {
         return m_solutionPath;
     }
 
+    const SolverStats& getStats() const {
+        return m_stats;
+    }
+
+    /**
+        Lets the solver store the boards in a table shared with other searches instead of its own table.
+        Only boards proven dead are reused between searches, so the table stays valid for every board of the layout.
+        \param table The shared table, which has to belong to the same board layout
+    */
+    void shareTranspositionTable(SharedTranspositionTable<Board>& table) {
+        m_sharedVisitedBoardStates = &table;
+    }
+
 protected:
-    bool backtrack(const std::chrono::time_point<std::chrono::system_clock>& startTime, std::chrono::milliseconds& timeout) {
-        std::chrono::time_point<std::chrono::system_clock> now = std::chrono::system_clock::now();
-        if (std::chrono::duration_cast<std::chrono::milliseconds>(now - startTime) > timeout) {
-            std::cout << "Timeout reached. No solution found." << std::endl;
-            return false;
+    /**
+        Creates the solver of a board, which starts with the given search strategy.
+        Only the buffers of this strategy are allocated, e.g. the threads of a ParallelSolver never reserve the beam.
+    */
+    Solver(const Layout& layout, const Board& board, std::size_t tableBytes, SearchStrategy strategy)
+        : m_layout{ layout }, m_board{ m_layout.toGridBoard(board) }, m_visitedBoardStates{ tableBytes, &m_heap },
+          m_pagodaValues(m_layout.pagodas.size(), 0, &m_heap), m_moveOrdering{ m_layout } {
+        m_solutionPath.reserve(kMaxDepth);
+        setSearchStrategy(strategy);
+    };
+
+    /**
+        Outcome of visiting a board during the search.
+    */
+    enum class VisitResult {
+        Search, // the board has to be searched
+        Pruned, // the board is unsolvable or was searched before
+        Busy, // another thread of the same parallel search is searching the board
+    };
+
+    /**
+        Gets the counters of the probes of the shared table made by this solver.
+    */
+    const typename SharedTranspositionTable<Board>::Counters& getSharedTableCounters() const {
+        return m_sharedTableCounters;
+    }
+
+    /**
+        Lets the solver take part in a parallel search: visited boards are stored in the shared table under the id
+        of the parallel search, the explored nodes are charged to the budget of the parallel search
+        and the search stops as soon as the stop flag is set.
+    */
+    void joinParallelSearch(SharedTranspositionTable<Board>& sharedVisitedBoardStates, uint32_t searchId, std::atomic<bool>& stopFlag,
+        SearchBudget& budget) {
+        m_sharedVisitedBoardStates = &sharedVisitedBoardStates;
+        m_searchId = searchId;
+        m_stopFlag = &stopFlag;
+        m_budget = &budget;
+    }
+
+    /**
+        Moves the search to a board reached from the initial board by the given moves.
+        \param gridBoard The board as grid bitboard
+        \param path The moves (in compact bit indices) leading to the board, the prefix of every solution found from it
+    */
+    void setBoard(const Board& gridBoard, const std::vector<MoveByte>& path) {
+        m_board = gridBoard;
+        for (std::size_t pagodaIdx = 0; pagodaIdx < m_pagodaValues.size(); ++pagodaIdx) {
+            m_pagodaValues[pagodaIdx] = m_layout.pagodas[pagodaIdx].value(m_board);
         }
-        
+        m_solutionPath.assign(path.begin(), path.end());
+    }
+
+    /**
+        Depth-first search on the explicit move stack, i.e. without recursion and without any allocation per level.
+        The limits of the budget are only checked every SearchBudget::kCheckInterval explored nodes.
+        \return True if a solution was found (the moves are stored in the solution path), false otherwise
+    */
+    bool backtrack() {
         if (foundSolution()) {
             return true;
         }
-        
-        if (m_visitedBoardStates.count(m_board)) {
+        if (visitBoard() != VisitResult::Search) {
             return false;
         }
-        else {
-            m_visitedBoardStates.insert(m_board);
-        }
-        
-        std::vector<MoveByte> candidateMoves = getNextPossibleMoves();
-        for (const MoveByte& move : candidateMoves) {
-            if (isValidMove(move)) {
-                applyMove(move);
-                m_solutionPath.push_back(move);
+        pushFrame(0);
+        std::size_t depth = 1;
+
+        while (depth > 0) {
+            if (m_stopFlag && m_stopFlag->load(std::memory_order_relaxed)) {
+                m_solutionPath.clear();
+                return false;
+            }
+            if (m_stats.nodesExplored - m_chargedNodes >= SearchBudget::kCheckInterval && !chargeBudget()) {
+                m_solutionPath.clear();
+                return false;
+            }
 
-                if (backtrack(startTime, timeout)) {
-                    return true;
+            SearchFrame<Board>& frame = m_moveStack[depth - 1];
+            if (!takeNextMove(frame, depth - 1)) {
+                // All jumps of this board are tried, go back to the previous board
+                if (m_sharedVisitedBoardStates) {
+                    if (frame.complete) {
+                        m_sharedVisitedBoardStates->markDead(canonical(), m_searchId, m_sharedTableCounters);
+                    } else if (depth > 1) {
+                        m_moveStack[depth - 2].complete = false;
+                    }
                 }
+                --depth;
+                if (depth > 0) {
+                    undoMove(m_moveStack[depth - 1].move);
+                    m_solutionPath.pop_back();
+                }
+                continue;
+            }
 
-                undoMove(move);
+            applyMove(frame.move);
+            m_solutionPath.push_back(m_layout.toBitIdxMove(frame.move));
+
+            if (foundSolution()) {
+                return true;
+            }
+            const VisitResult visit = visitBoard();
+            if (visit != VisitResult::Search) {
+                frame.complete = frame.complete && visit != VisitResult::Busy;
+                undoMove(frame.move);
                 m_solutionPath.pop_back();
+                continue;
             }
+            pushFrame(depth++);
         }
         return false;
     }
 
+    /**
+        Collects the moves of the current board in the order the search tries them.
+        \param moves Receives the moves in grid bits, room for kMaxMoves moves
+        \return The number of moves
+    */
+    std::size_t collectMoves(MoveByte* moves) {
+        const JumpSet jumps = getNextPossibleMoves();
+        std::size_t moveCount = 0;
+        for (std::size_t direction = 0; direction < jumps.size(); ++direction) {
+            for (Board origins = jumps[direction]; origins != Board{}; origins = withoutLowestBit(origins)) {
+                const MoveByte move = gridMove(lowestBitIndex(origins), direction);
+                if (m_searchStrategy == SearchStrategy::DepthFirst) {
+                    moves[moveCount++] = move;
+                    continue;
+                }
+                // Insertion sort by descending score, moves with equal scores keep their order
+                const int score = m_moveOrdering.scoreMove(move, m_board ^ moveMask(move), pagodaSlack(move));
+                std::size_t position = moveCount++;
+                for (; position > 0 && m_moveScores[position - 1] < score; --position) {
+                    moves[position] = moves[position - 1];
+                    m_moveScores[position] = m_moveScores[position - 1];
+                }
+                moves[position] = move;
+                m_moveScores[position] = score;
+            }
+        }
+        return moveCount;
+    }
 
-    void applyMove(const MoveByte& move) {
-        m_board &= ~(1ULL << move.from);
-        m_board &= ~(1ULL << move.over);
-        m_board |= (1ULL << move.to);
+    /**
+        Gets the smallest difference of a pagoda value to its goal value after a move (in grid bits) of the current board.
+    */
+    int pagodaSlack(const MoveByte& move) const {
+        int slack = 0;
+        for (std::size_t pagodaIdx = 0; pagodaIdx < m_pagodaValues.size(); ++pagodaIdx) {
+            const typename Layout::Pagoda& pagoda = m_layout.pagodas[pagodaIdx];
+            const int pagodaSlack = m_pagodaValues[pagodaIdx] + pagoda.delta(move) - pagoda.goalValue;
+            slack = pagodaIdx == 0 ? pagodaSlack : std::min(slack, pagodaSlack);
+        }
+        return slack;
     }
 
-    void undoMove(const MoveByte& move) {
-        m_board |= (1ULL << move.from);
-        m_board |= (1ULL << move.over);
-        m_board &= ~(1ULL << move.to);
+    static Board moveMask(const MoveByte& move) {
+        return singleBit<Board>(move.from) | singleBit<Board>(move.over) | singleBit<Board>(move.to);
     }
 
-    bool isValidMove(const MoveByte& move) const {
-        return ((m_board & (1ULL << move.from)) && (m_board & (1ULL << move.over)) && !(m_board & (1ULL << move.to)));
+private:
+    /**
+        Puts the current board on the move stack at the given level.
+    */
+    void pushFrame(std::size_t level) {
+        if (m_searchStrategy == SearchStrategy::DepthFirst) {
+            m_moveStack[level] = SearchFrame<Board>{ getNextPossibleMoves() };
+            return;
+        }
+        m_moveStack[level] = SearchFrame<Board>{};
+        m_moveStack[level].moveCount = static_cast<uint16_t>(collectMoves(&m_orderedMoves[level * kMaxMoves]));
     }
 
-    virtual bool foundSolution() = 0;
+    /**
+        Takes the next untried move of a level of the move stack into frame.move.
+        \return False if all moves of the level are tried
+    */
+    bool takeNextMove(SearchFrame<Board>& frame, std::size_t level) {
+        if (m_searchStrategy != SearchStrategy::DepthFirst) {
+            if (frame.nextMove == frame.moveCount) {
+                return false;
+            }
+            frame.move = m_orderedMoves[level * kMaxMoves + frame.nextMove++];
+            return true;
+        }
+        while (frame.direction < frame.remainingJumps.size() && frame.remainingJumps[frame.direction] == Board{}) {
+            ++frame.direction;
+        }
+        if (frame.direction == frame.remainingJumps.size()) {
+            return false;
+        }
+        Board& origins = frame.remainingJumps[frame.direction];
+        frame.move = gridMove(lowestBitIndex(origins), frame.direction);
+        origins = withoutLowestBit(origins);
+        return true;
+    }
 
-    virtual std::vector<MoveByte> getNextPossibleMoves() = 0;
+    /**
+        Beam search: every level keeps only the m_beamWidth best boards by MoveOrdering::scoreBoard, distinct up to symmetry.
+        The search is incomplete, a board may be solvable although the beam search finds no solution.
+        \return True if a solution was found (the moves are stored in the solution path), false otherwise
+    */
+    bool beamSearch() {
+        using Node = BeamNode<Board>;
+        const Board initialBoard = m_board;
+        std::pmr::vector<Node>& successors = m_beamSuccessors;
+        m_beamNodes.clear();
+        m_beamNodes.push_back(Node{ initialBoard, canonical(), 0, 0, MoveByte(0, 0, 0) });
+        std::size_t levelCount = 1;
+        m_beamLevelStarts[0] = 0;
+        m_beamLevelStarts[1] = 1;
+        bool solved = false;
 
-    virtual void canonical() = 0;
+        while (!solved && m_beamLevelStarts[levelCount] > m_beamLevelStarts[levelCount - 1]) {
+            successors.clear();
+            const Node* level = m_beamNodes.data() + m_beamLevelStarts[levelCount - 1];
+            const std::size_t levelSize = m_beamLevelStarts[levelCount] - m_beamLevelStarts[levelCount - 1];
+            for (uint32_t nodeIdx = 0; nodeIdx < levelSize && !solved; ++nodeIdx) {
+                ++m_stats.nodesExplored;
+                if (m_stats.nodesExplored - m_chargedNodes >= SearchBudget::kCheckInterval && !chargeBudget()) {
+                    m_board = initialBoard;
+                    return false;
+                }
+                m_board = level[nodeIdx].board;
+                for (std::size_t pagodaIdx = 0; pagodaIdx < m_pagodaValues.size(); ++pagodaIdx) {
+                    m_pagodaValues[pagodaIdx] = m_layout.pagodas[pagodaIdx].value(m_board);
+                }
+                const JumpSet jumps = getNextPossibleMoves();
+                for (std::size_t direction = 0; direction < jumps.size() && !solved; ++direction) {
+                    for (Board origins = jumps[direction]; origins != Board{}; origins = withoutLowestBit(origins)) {
+                        const MoveByte move = gridMove(lowestBitIndex(origins), direction);
+                        const int slack = pagodaSlack(move);
+                        if (slack < 0) {
+                            ++m_stats.pagodaPrunes;
+                            continue;
+                        }
+                        applyMove(move);
+                        successors.push_back(Node{ m_board, canonical(), m_moveOrdering.scoreBoard(m_board, slack), nodeIdx, move });
+                        solved = foundSolution();
+                        undoMove(move);
+                        if (solved) {
+                            break;
+                        }
+                    }
+                }
+            }
+            if (solved) {
+                break;
+            }
 
-};
+            // Keeps the best board of every symmetry class, then the best boards of the level
+            std::sort(successors.begin(), successors.end(), [](const Node& lhs, const Node& rhs) {
+                return lhs.key != rhs.key ? lhs.key < rhs.key : lhs.score > rhs.score;
+            });
+            const std::size_t successorCount = successors.size();
+            successors.erase(std::unique(successors.begin(), successors.end(),
+                [](const Node& lhs, const Node& rhs) { return lhs.key == rhs.key; }), successors.end());
+            m_stats.transpositionHits += successorCount - successors.size();
+            if (successors.size() > m_beamWidth) {
+                std::nth_element(successors.begin(), successors.begin() + static_cast<std::ptrdiff_t>(m_beamWidth), successors.end(),
+                    [](const Node& lhs, const Node& rhs) { return lhs.score > rhs.score; });
+                successors.erase(successors.begin() + static_cast<std::ptrdiff_t>(m_beamWidth), successors.end());
+            }
+            m_beamNodes.insert(m_beamNodes.end(), successors.begin(), successors.end());
+            m_beamLevelStarts[++levelCount] = m_beamNodes.size();
+        }
 
+        m_board = initialBoard;
+        for (std::size_t pagodaIdx = 0; pagodaIdx < m_pagodaValues.size(); ++pagodaIdx) {
+            m_pagodaValues[pagodaIdx] = m_layout.pagodas[pagodaIdx].value(m_board);
+        }
+        if (!solved) {
+            return false;
+        }
+        // Follows the parents from the goal back to the initial board
+        m_solutionPath.push_back(m_layout.toBitIdxMove(successors.back().move));
+        for (std::size_t nodeIdx = successors.back().parent, levelIdx = levelCount - 1; levelIdx > 0; --levelIdx) {
+            const Node& node = m_beamNodes[m_beamLevelStarts[levelIdx] + nodeIdx];
+            m_solutionPath.push_back(m_layout.toBitIdxMove(node.move));
+            nodeIdx = node.parent;
+        }
+        std::reverse(m_solutionPath.begin(), m_solutionPath.end());
+        return true;
+    }
 
-class EnglishBoardSolver : public Solver {
-private:
-    static const uint64_t m_solutionBoard = 0x10000;
-    const std::array<MoveByte, 76> m_allMovePatterns = {{
-        // Horizontal moves
-        {0,1,2}, {2,1,0},
-        {3,4,5}, {5,4,3},
-        {6,7,8}, {7,8,9}, {8,9,10}, {8,7,6}, {9,10,11}, {9,8,7}, {10,11,12}, {10,9,8}, {11,10,9}, {12,11,10},
-        {13,14,15}, {14,15,16}, {15,16,17}, {16,17,18}, {17,18,19}, {15,14,13}, {16,15,14}, {17,16,15}, {18,17,16}, {19,18,17},
-        {20,21,22}, {21,22,23}, {22,23,24}, {23,24,25}, {24,25,26}, {22,21,20}, {23,22,21}, {24,23,22}, {25,24,23}, {26,25,24},
-        {27,28,29}, {29,28,27},
-        {30,31,32}, {32,31,30},
-        // Vertical moves
-        {0,3,8}, {1,4,9}, {2,5,10},
-        {3,8,15}, {4,9,16}, {5,10,17},
-        {6,13,20}, {7,14,21}, {8,15,22}, {8,3,0}, {9,16,23}, {9,4,1}, {10,17,24}, {10,5,2}, {11,18,25}, {12,19,26},
-        {15,8,3}, {15,22,27}, {16,9,4}, {16,23,28}, {17,10,5}, {17,24,29},
-        {20,13,6}, {21,14,7}, {22,15,8}, {22,27,30}, {23,16,9}, {23,28,31}, {24,17,10}, {24,29,32}, {25,18,11}, {26,19,12},
-        {27,22,15}, {28,23,16}, {29,24,17},
-        {30,27,22}, {31,28,23}, {32,29,24}
-    }};
+protected:
 
-public:
-    EnglishBoardSolver(uint64_t board) : Solver(board) {};
+    /**
+        Charges the nodes explored since the last check to the budget. If a limit is reached, all threads of a parallel search are stopped.
+        \return True if the search may go on, false otherwise
+    */
+    bool chargeBudget() {
+        const bool canContinue = m_budget->charge(m_stats.nodesExplored - m_chargedNodes);
+        m_chargedNodes = m_stats.nodesExplored;
+        if (!canContinue && m_stopFlag) {
+            m_stopFlag->store(true);
+        }
+        return canContinue;
+    }
 
-protected:
-    std::vector<MoveByte> getNextPossibleMoves() override {
-        std::vector<MoveByte> possibleMoves;
-        for (const auto& move : m_allMovePatterns) {
-            if (isValidMove(move)) {
-                possibleMoves.push_back(move);
+    /**
+        Marks the current board as visited, unless a pagoda function already proves that it is unsolvable.
+        Only the canonical form is stored, the board itself is never transformed,
+        so the solution path is always given in the real orientation of the board.
+        \return Whether the board has to be searched
+    */
+    VisitResult visitBoard() {
+        for (std::size_t pagodaIdx = 0; pagodaIdx < m_pagodaValues.size(); ++pagodaIdx) {
+            if (m_pagodaValues[pagodaIdx] < m_layout.pagodas[pagodaIdx].goalValue) {
+                ++m_stats.pagodaPrunes;
+                return VisitResult::Pruned;
+            }
+        }
+        if (m_sharedVisitedBoardStates) {
+            switch (m_sharedVisitedBoardStates->claim(canonical(), m_searchId, m_sharedTableCounters)) {
+            case SharedTranspositionTable<Board>::ClaimResult::Dead:
+                ++m_stats.transpositionHits;
+                return VisitResult::Pruned;
+            case SharedTranspositionTable<Board>::ClaimResult::Busy:
+                ++m_stats.transpositionHits;
+                return VisitResult::Busy;
+            default:
+                break;
             }
+        } else if (!m_visitedBoardStates.insert(canonical())) {
+            ++m_stats.transpositionHits;
+            return VisitResult::Pruned;
         }
-        return possibleMoves;
+        ++m_stats.nodesExplored;
+        return VisitResult::Search;
     }
 
-    bool foundSolution() override {
-        return m_board == m_solutionBoard;
-	}
-
-    void canonical() override {
-        // TODO: Implement symmetry reduction logic here later on
-	}
-};
 
+    void applyMove(const MoveByte& move) {
+        m_board &= ~singleBit<Board>(move.from);
+        m_board &= ~singleBit<Board>(move.over);
+        m_board |= singleBit<Board>(move.to);
+        for (std::size_t pagodaIdx = 0; pagodaIdx < m_pagodaValues.size(); ++pagodaIdx) {
+            m_pagodaValues[pagodaIdx] += m_layout.pagodas[pagodaIdx].delta(move);
+        }
+    }
 
-class EuropeanBoardSolver : public Solver {
-private:
-    static const uint64_t m_solutionBoard = 0x1000000000;
-    const std::array<MoveByte, 92> m_allMovePatterns = { {
-            // Horizontal moves
-            {0,1,2}, {2,1,0},
-            {3,4,5}, {4,5,6}, {5,6,7}, {5,4,3}, {6,5,4}, {7,6,5},
-            {8,9,10}, {9,10,11}, {10,11,12}, {11,12,13}, {12,13,14}, {10,9,8}, {11,10,9}, {12,11,10}, {13,12,11}, {14,13,12},
-            {15,16,17}, {16,17,18}, {17,18,19}, {18,19,20}, {19,20,21}, {17,16,15}, {18,17,16}, {19,18,17}, {20,19,18}, {21,20,19},
-            {22,23,24}, {23,24,25}, {24,25,26}, {25,26,27}, {26,27,28}, {24,23,22}, {25,24,23}, {26,25,24}, {27,26,25}, {28,27,26},
-            {29,30,31}, {30,31,32}, {31,32,33}, {31,30,29}, {32,31,30}, {33,32,31},
-            {34,35,36}, {36,35,34},
-            // Vertical moves
-            {0,4,10}, {1,5,11}, {2,6,12},
-            {3,9,16}, {4,10,17}, {5,11,18}, {6,12,19}, {7,13,20},
-            {8,15,22}, {9,16,23}, {10,17,24}, {10,4,0}, {11,18,25}, {11,5,1}, {12,19,26}, {12,6,2}, {13,20,27}, {14,21,28},
-            {16,9,3}, {16,23,29}, {17,10,4}, {17,24,30}, {18,11,5}, {18,25,31}, {19,12,6}, {19,26,32}, {20,13,7}, {20,27,33},
-            {22,15,8}, {23,16,9}, {24,17,10}, {24,30,34}, {25,18,11}, {25,31,35}, {26,19,12}, {26,32,36}, {27,20,13}, {28,21,14},
-            {29,23,16}, {30,24,17}, {31,25,18}, {32,26,19}, {33,27,20},
-            {34,30,24}, {35,31,25}, {36,32,26}
-        } };
+    void undoMove(const MoveByte& move) {
+        m_board |= singleBit<Board>(move.from);
+        m_board |= singleBit<Board>(move.over);
+        m_board &= ~singleBit<Board>(move.to);
+        for (std::size_t pagodaIdx = 0; pagodaIdx < m_pagodaValues.size(); ++pagodaIdx) {
+            m_pagodaValues[pagodaIdx] -= m_layout.pagodas[pagodaIdx].delta(move);
+        }
+    }
 
-public:
-    EuropeanBoardSolver(uint64_t board) : Solver(board) {};
+    bool foundSolution() const {
+        if constexpr (Bounds::kIsLoaded) {
+            return m_board == m_layout.solutionBoard;
+        } else {
+            return m_board == BoardTraits::kTables.gridSolutionBoard;
+        }
+    }
 
-protected:
-    std::vector<MoveByte> getNextPossibleMoves() override {
-        std::vector<MoveByte> possibleMoves;
-        for (const auto& move : m_allMovePatterns) {
-            if (isValidMove(move)) {
-                possibleMoves.push_back(move);
-            }
+    JumpSet getNextPossibleMoves() const {
+        if constexpr (Bounds::kIsLoaded) {
+            return m_layout.legalJumps(m_board);
+        } else {
+            return Layout::legalJumps(m_board, BoardTraits::kTables.jumpOrigins, BoardTraits::kTables.cols);
         }
-        return possibleMoves;
     }
 
-    bool foundSolution() override {
-        return m_board == m_solutionBoard;
+    MoveByte gridMove(unsigned int from, std::size_t direction) const {
+        if constexpr (Bounds::kIsLoaded) {
+            return m_layout.gridMove(from, direction);
+        } else {
+            return Layout::gridMove(from, direction, BoardTraits::kTables.cols);
+        }
     }
 
-    void canonical() override {
-        // TODO: Implement symmetry reduction logic here later on
+    /**
+        Gets the canonical form of the current board, the symmetry count is known at compile time for the built-in boards.
+    */
+    Board canonical() const {
+        if constexpr (Bounds::kIsLoaded) {
+            return m_layout.canonicalize(m_board);
+        } else {
+            constexpr std::size_t symmetryCount = BoardTraits::kTables.symmetryCount(); // symmetries besides the identity
+            Board canonicalBoard = m_board;
+            for (std::size_t symmetryIdx = 0; symmetryIdx < symmetryCount; ++symmetryIdx) {
+                canonicalBoard = std::min(canonicalBoard, m_layout.symmetries[symmetryIdx].apply(m_board));
+            }
+            return canonicalBoard;
+        }
     }
 };
 
 
-class AsymmetricBoardSolver : public Solver {
-private:
-    static const uint64_t m_solutionBoard = 0x100000;
-    const std::array<MoveByte, 96> m_allMovePatterns = { {
-            // Horizontal moves
-            {0,1,2}, {2,1,0},
-            {3,4,5}, {5,4,3},
-            {6,7,8}, {8,7,6},
-            {9,10,11}, {10,11,12}, {11,12,13}, {12,13,14}, {13,14,15}, {14,15,16}, {11,10,9}, {12,11,10}, {13,12,11}, {14,13,12}, {15,14,13}, {16,15,14},
-            {17,18,19}, {18,19,20}, {19,20,21}, {20,21,22}, {21,22,23}, {22,23,24}, {19,18,17}, {20,19,18}, {21,20,19}, {22,21,20}, {23,22,21}, {24,23,22},
-            {25,26,27}, {26,27,28}, {27,28,29}, {28,29,30}, {29,30,31}, {30,31,32}, {27,26,25}, {28,27,26}, {29,28,27}, {30,29,28}, {31,30,29}, {32,31,30},
-            {33,34,25}, {35,34,33},
-            {36,37,38}, {38,37,36},
-            // Vertical moves
-            {0,3,6}, {1,4,7}, {2,5,8},
-            {3,6,11}, {4,7,12}, {5,8,13},
-            {6,3,0}, {6,11,19}, {7,4,1}, {7,12,20}, {8,5,2}, {8,13,21},
-            {9,17,25}, {10,18,26}, {11,6,3}, {11,19,27}, {12,7,4}, {12,20,28}, {13,8,5}, {13,21,29}, {14,22,30}, {14,22,30}, {15,23,31}, {16,24,32},
-            {19,11,6}, {19,27,33}, {20,12,7}, {20,28,34}, {21,13,8}, {21,29,35}, {30,22,14}, {31,23,15}, {32,24,16},
-            {25,17,9}, {26,18,10}, {27,19,11}, {27,33,36}, {28,20,12}, {28,34,37}, {29,21,13}, {29,35,38}, {30,22,14}, {31,23,15}, {32,24,16},
-            {33,27,19}, {34,28,20}, {35,29,21},
-            {36,33,27}, {37,34,28}, {38,35,29}
-        } };
+template <typename Key>
+SharedTranspositionTable<Key>& SharedTranspositionTable<Key>::forLayout(const BasicBoardLayout<Key>& layout) {
+    static std::mutex tablesMutex;
+    static std::map<const BasicBoardLayout<Key>*, std::unique_ptr<SharedTranspositionTable>> tables;
+    std::lock_guard<std::mutex> lock(tablesMutex);
+    std::unique_ptr<SharedTranspositionTable>& table = tables[&layout];
+    if (!table) {
+        table = std::make_unique<SharedTranspositionTable>(kDefaultTableBytes);
+    }
+    return *table;
+}
+
 
+using EnglishBoardSolver = Solver<EnglishBoardTraits>;
+using EuropeanBoardSolver = Solver<EuropeanBoardTraits>;
+using AsymmetricBoardSolver = Solver<AsymmetricBoardTraits>;
+using SmallDiamondBoardSolver = Solver<SmallDiamondBoardTraits>;
+
+
+/**
+    Solver running the depth-first search on several threads.
+    The boards of the first kSplitDepth levels are split into tasks, which are distributed over one deque per thread.
+    A thread takes its newest task (the deepest, keeping its work local) and, once its own deque is empty,
+    steals the oldest task of another thread (the shallowest, i.e. the largest amount of work).
+    Deeper boards are searched by the sequential depth-first search of the thread.
+    All threads share one lock-free table of visited boards, so a board is only searched by the thread that claimed it first,
+    and all of them stop as soon as one finds a solution. The table may also be shared with other searches of the layout.
+*/
+template <typename BoardTraits>
+class ParallelSolver {
 public:
-    AsymmetricBoardSolver(uint64_t board) : Solver(board) {};
+    using Board = typename Solver<BoardTraits>::Board;
+    using Layout = typename Solver<BoardTraits>::Layout;
+    static constexpr std::size_t kSplitDepth = 3; // boards up to this number of moves are distributed as tasks
 
-protected:
-    std::vector<MoveByte> getNextPossibleMoves() override {
-        std::vector<MoveByte> possibleMoves;
-        for (const auto& move : m_allMovePatterns) {
-            if (isValidMove(move)) {
-                possibleMoves.push_back(move);
+private:
+    /**
+        A board to search together with the moves leading to it.
+    */
+    struct SearchTask {
+        Board board{}; // grid bitboard
+        std::vector<MoveByte> path{}; // moves in compact bit indices
+    };
+
+    /**
+        Deque of tasks of one thread.
+    */
+    struct TaskQueue {
+        std::mutex mutex;
+        std::deque<SearchTask> tasks;
+    };
+
+    /**
+        Sequential search of one thread working on the shared table.
+    */
+    class Worker : public Solver<BoardTraits> {
+        using Base = Solver<BoardTraits>;
+        using Base::m_layout;
+        using Base::joinParallelSearch;
+        using Base::getSharedTableCounters;
+        using Base::setBoard;
+        using Base::backtrack;
+        using Base::foundSolution;
+        using Base::visitBoard;
+        using Base::collectMoves;
+        using Base::moveMask;
+
+        std::vector<MoveByte> m_splitMoves; // moves of a board split into tasks, room for kMaxMoves moves
+
+    public:
+        Worker(const Layout& layout, SharedTranspositionTable<Board>& sharedVisitedBoardStates, uint32_t searchId, std::atomic<bool>& stopFlag,
+               SearchBudget& budget)
+            : Base(layout, Board{}, 0, SearchStrategy::DepthFirst), // the own table is not used, so it gets the minimum size
+              m_splitMoves(Base::kMaxMoves) {
+            joinParallelSearch(sharedVisitedBoardStates, searchId, stopFlag, budget);
+        }
+
+        const typename SharedTranspositionTable<Board>::Counters& getTableCounters() const {
+            return getSharedTableCounters();
+        }
+
+        /**
+            Searches one task: boards above the split depth are expanded into new tasks, deeper ones are searched completely.
+            \return True if a solution was found (the moves are stored in the solution path), false otherwise
+        */
+        bool run(const SearchTask& task, ParallelSolver& solver, std::size_t queueIdx) {
+            setBoard(task.board, task.path);
+            if (task.path.size() >= kSplitDepth) {
+                return backtrack();
             }
+            if (foundSolution()) {
+                return true;
+            }
+            if (visitBoard() != Base::VisitResult::Search) {
+                return false;
+            }
+            const std::size_t moveCount = collectMoves(m_splitMoves.data());
+            // Pushed in reverse, the thread takes the children in the order of the sequential search
+            for (std::size_t moveIdx = moveCount; moveIdx > 0; --moveIdx) {
+                const MoveByte& move = m_splitMoves[moveIdx - 1];
+                SearchTask child{ task.board ^ moveMask(move), task.path };
+                child.path.push_back(m_layout.toBitIdxMove(move));
+                solver.pushTask(queueIdx, std::move(child));
+            }
+            return false;
         }
-        return possibleMoves;
-    }
+    };
+
+    const Layout& m_layout;
+    Board m_board; // initial board as grid bitboard
+    unsigned int m_threadCount;
+    std::unique_ptr<SharedTranspositionTable<Board>> m_ownVisitedBoardStates; // only created if no shared table is given
+    SharedTranspositionTable<Board>& m_visitedBoardStates;
+    std::atomic<bool> m_stopFlag{ false };
+    std::atomic<std::size_t> m_pendingTasks{ 0 }; // tasks queued or running, the search is over when it drops to zero
+    std::vector<TaskQueue> m_queues;
+    std::mutex m_idleMutex;
+    std::condition_variable m_idleCondition; // idle threads wait for a new task, the end of the search or the stop flag
+    std::atomic<std::size_t> m_taskPushes{ 0 }; // changed under m_idleMutex, so a waiting thread cannot miss a push
+    std::mutex m_solutionMutex;
+    std::vector<MoveByte> m_solutionPath{};
+    SolverStats m_stats{};
+    SearchStrategy m_searchStrategy{ SearchStrategy::DepthFirst };
 
-    bool foundSolution() override {
-        return m_board == m_solutionBoard;
+    void pushTask(std::size_t queueIdx, SearchTask task) {
+        m_pendingTasks.fetch_add(1);
+        {
+            std::lock_guard<std::mutex> lock(m_queues[queueIdx].mutex);
+            m_queues[queueIdx].tasks.push_back(std::move(task));
+        }
+        {
+            std::lock_guard<std::mutex> lock(m_idleMutex);
+            m_taskPushes.fetch_add(1);
+        }
+        m_idleCondition.notify_one();
     }
 
-    void canonical() override {
-        // TODO: Implement symmetry reduction logic here later on
+    /**
+        Wakes all idle threads after the search is over or stopped.
+    */
+    void wakeIdleThreads() {
+        {
+            std::lock_guard<std::mutex> lock(m_idleMutex); // a thread checking its wait condition sees the change before it waits
+        }
+        m_idleCondition.notify_all();
     }
-};
 
+    /**
+        Takes the newest task of the own deque or, if it is empty, steals the oldest task of another deque.
+    */
+    bool takeTask(std::size_t queueIdx, SearchTask& task) {
+        for (std::size_t offset = 0; offset < m_queues.size(); ++offset) {
+            TaskQueue& queue = m_queues[(queueIdx + offset) % m_queues.size()];
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            if (queue.tasks.empty()) {
+                continue;
+            }
+            if (offset == 0) {
+                task = std::move(queue.tasks.back());
+                queue.tasks.pop_back();
+            } else {
+                task = std::move(queue.tasks.front());
+                queue.tasks.pop_front();
+            }
+            return true;
+        }
+        return false;
+    }
 
-class SmallDiamondBoardSolver : public Solver {
-private:
-    static const uint64_t m_solutionBoard = 0x1000;
-    const std::array<MoveByte, 72> m_allMovePatterns = { {
-        // Horizontal moves
-        {1,2,3}, {3,2,1}, 
-        {4,5,6}, {5,6,7}, {6,5,4}, {6,7,8}, {7,6,5}, {8,7,6},
-        {9,10,11}, {10,11,12}, {11,12,13}, {11,10,9}, {12,13,14}, {12,11,10}, {13,14,15}, {13,12,11}, {14,13,12}, {15,14,13},
-		{16,17,18}, {17,18,19}, {18,19,20}, {19,20,21}, {20,21,22}, {18,17,16}, {19,18,17}, {20,19,18}, {21,20,19}, {22,21,20},
-        {23,24,25}, {24,25,26}, {25,26,27}, {25,24,23}, {26,25,24}, {27,26,25},
-        {28,29,30}, {30,29,28},
-
-        // Vertical moves
-        {0,2,6}, 
-        {1,5,11}, {2,6,12}, {3,7,13},
-        {4,10,17}, {5,11,18}, {6,12,19}, {6,2,0}, {7,13,20}, {8,14,21},
-        {10,17,23}, {11,18,24}, {11,5,1}, {12,19,25}, {12,6,2}, {13,20,26}, {13,7,3}, {14,21,27}, 
-        {17,10,4}, {18,11,5}, {18,24,28}, {19,12,6}, {19,25,29}, {20,13,7}, {20,26,30}, {21,14,8},
-        {23,17,10}, {24,18,11}, {25,19,12}, {25,29,31}, {26,20,13}, {27,21,14},
-        {28,24,18}, {29,25,19}, {30,26,20},
-        {31,29,25}
-    }};
+    void work(Worker& worker, std::size_t queueIdx) {
+        SearchTask task;
+        while (!m_stopFlag.load(std::memory_order_relaxed)) {
+            const std::size_t taskPushes = m_taskPushes.load(); // read before looking for a task, so a later push ends the wait
+            if (!takeTask(queueIdx, task)) {
+                std::unique_lock<std::mutex> lock(m_idleMutex);
+                m_idleCondition.wait(lock, [this, taskPushes]() {
+                    return m_stopFlag.load() || m_pendingTasks.load() == 0 || m_taskPushes.load() != taskPushes;
+                });
+                if (m_pendingTasks.load() == 0) {
+                    return;
+                }
+                continue;
+            }
+            if (worker.run(task, *this, queueIdx)) {
+                std::lock_guard<std::mutex> lock(m_solutionMutex);
+                if (!m_stopFlag.exchange(true)) {
+                    m_solutionPath.assign(worker.getSolutionPath().begin(), worker.getSolutionPath().end());
+                }
+            }
+            // The last task ends the search, a solution or an exhausted budget (see chargeBudget()) stops it
+            if (m_pendingTasks.fetch_sub(1) == 1 || m_stopFlag.load()) {
+                wakeIdleThreads();
+            }
+        }
+    }
 
 public:
-    SmallDiamondBoardSolver(uint64_t board) : Solver(board) {};
+    /**
+        Creates a parallel solver.
+        \param board The board to solve in compact format
+        \param threadCount The number of threads (0 uses all hardware threads)
+        \param sharedTable The transposition table shared with other searches of the layout (the solver creates its own if null)
+    */
+    ParallelSolver(const Board& board, unsigned int threadCount = 0, SharedTranspositionTable<Board>* sharedTable = nullptr)
+        : ParallelSolver(BoardTraits::layout(), board, threadCount, sharedTable) {
+    }
 
-protected:
-    std::vector<MoveByte> getNextPossibleMoves() override {
-        std::vector<MoveByte> possibleMoves;
-        for (const auto& move : m_allMovePatterns) {
-            if (isValidMove(move)) {
-                possibleMoves.push_back(move);
-            }
+    /**
+        Creates a parallel solver with the given layout, which is needed for boards loaded from a file (see BoardDefinition.h).
+        \param layout The layout of the board, which has to outlive the solver
+        \param board The board to solve in compact format
+        \param threadCount The number of threads (0 uses all hardware threads)
+        \param sharedTable The transposition table shared with other searches of the layout (the solver creates its own if null)
+    */
+    ParallelSolver(const Layout& layout, const Board& board, unsigned int threadCount = 0, SharedTranspositionTable<Board>* sharedTable = nullptr)
+        : m_layout{ layout }, m_board{ m_layout.toGridBoard(board) },
+          m_threadCount{ threadCount != 0 ? threadCount : std::max(1U, std::thread::hardware_concurrency()) },
+          m_ownVisitedBoardStates{ sharedTable ? nullptr : std::make_unique<SharedTranspositionTable<Board>>(kDefaultTableBytes) },
+          m_visitedBoardStates{ sharedTable ? *sharedTable : *m_ownVisitedBoardStates }, m_queues(m_threadCount) {
+        m_solutionPath.reserve(Solver<BoardTraits>::kMaxDepth);
+    }
+
+    /**
+        Selects how the threads order their moves. The beam search does not split into tasks,
+        so SearchStrategy::Beam is searched by the ordered depth-first search.
+    */
+    void setSearchStrategy(SearchStrategy strategy) {
+        m_searchStrategy = strategy == SearchStrategy::Beam ? SearchStrategy::OrderedDepthFirst : strategy;
+    }
+
+    /**
+        Searches a solution of the board on all threads within the limits of a budget, which all threads charge together.
+        \param budget The limits of the search
+        \return Whether a solution was found, the search was completed without one or stopped by a limit
+    */
+    SolveResult solve(SearchBudget& budget) {
+        m_solutionPath.clear();
+        m_stats = SolverStats{};
+        if (!budget.charge(0)) {
+            return SolveResult{ budget.stopStatus(), 0 };
+        }
+        if (m_layout.positionClass(m_board) != m_layout.positionClass(m_layout.solutionBoard)) {
+            ++m_stats.positionClassRejections;
+            return SolveResult{ SolveResult::Status::Unsolvable, 0 };
+        }
+        const uint32_t searchId = m_visitedBoardStates.beginSearch();
+        m_stopFlag = false;
+        m_pendingTasks = 0;
+        pushTask(0, SearchTask{ m_board, {} });
+
+        std::vector<std::unique_ptr<Worker>> workers;
+        for (unsigned int threadIdx = 0; threadIdx < m_threadCount; ++threadIdx) {
+            workers.push_back(std::make_unique<Worker>(m_layout, m_visitedBoardStates, searchId, m_stopFlag, budget));
+            workers.back()->setSearchStrategy(m_searchStrategy);
         }
-        return possibleMoves;
+        std::vector<std::thread> threads;
+        for (unsigned int threadIdx = 1; threadIdx < m_threadCount; ++threadIdx) {
+            threads.emplace_back([this, &workers, threadIdx]() {
+                work(*workers[threadIdx], threadIdx);
+            });
+        }
+        work(*workers[0], 0);
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+        for (TaskQueue& queue : m_queues) {
+            queue.tasks.clear();
+        }
+
+        for (const std::unique_ptr<Worker>& worker : workers) {
+            m_stats.nodesExplored += worker->getStats().nodesExplored;
+            m_stats.transpositionHits += worker->getStats().transpositionHits;
+            m_stats.pagodaPrunes += worker->getStats().pagodaPrunes;
+            m_stats.tableCollisions += worker->getTableCounters().collisions;
+            m_stats.tableReplacements += worker->getTableCounters().replacements;
+        }
+        m_stats.tableCapacity = m_visitedBoardStates.capacity();
+        m_stats.tableEntries = m_visitedBoardStates.entries();
+        const bool solved = !m_solutionPath.empty() || m_board == m_layout.solutionBoard;
+        return SolveResult{ solved ? SolveResult::Status::Solved : budget.stopStatus(), m_stats.nodesExplored };
     }
 
-    bool foundSolution() override {
-        return m_board == m_solutionBoard;
+    /**
+        Gets the moves of the found solution path in the compact bit indices of GameLogic.
+    */
+    std::vector<MoveByte>& getSolutionPath() {
+        return m_solutionPath;
     }
 
-    void canonical() override {
-        // TODO: Implement symmetry reduction logic here later on
+    const SolverStats& getStats() const {
+        return m_stats;
     }
 };
@@ -3,6 +3,7 @@
 #include <iostream>
 #include <stdexcept>
 #include "UserInterface.h"
+#include "BoardDefinition.h"
 #include "Move.h"
 
 
@@ -52,24 +53,23 @@ void UserInterface::drawGoalField(int row, int col) {
 }
 
 void UserInterface::drawBoard() {
-	// Draw the goal field based on the board type
-	switch (m_gameLogic.getBoardType()) {
-	case BoardType::English:
-	case BoardType::SmallDiamond:
-		drawGoalField(3, 3);
-		break;
-	case BoardType::European:
-		drawGoalField(6, 4);
-		break;
-	case BoardType::Asymmetric:
-		drawGoalField(4, 3);
-		break;
-	default:
-		break;
+	// Draw the goal fields, i.e. the pegs of the goal board of the loaded board
+	const BoardTables& tables = m_gameLogic.getLoadedBoard().tables;
+	for (uint64_t goalPegs = tables.solutionBoard; goalPegs != 0; goalPegs &= goalPegs - 1) {
+		const auto [row, col] = tables.position(lowestBitIndex(goalPegs));
+		drawGoalField(row, col);
 	}
-	// Draw the board fields
-	for (auto& field : m_gameLogic.getBoard()) {		
-		m_window.draw(fieldToShape[&field]);
+	// Draw the board fields, the playable pegs are looked up in the legal jumps maintained by the game logic
+	const uint64_t playablePegs = m_showPlayablePegs ? m_gameLogic.getPlayablePegs() : 0;
+	for (auto& field : m_gameLogic.getBoard()) {
+		if ((playablePegs >> field.getBitIdx()) & 1) {
+			sf::CircleShape playableShape = fieldToShape[&field];
+			playableShape.setOutlineColor(sf::Color::Green);
+			playableShape.setOutlineThickness(3.f);
+			m_window.draw(playableShape);
+		} else {
+			m_window.draw(fieldToShape[&field]);
+		}
 	}
 }
 
@@ -144,49 +144,19 @@ void UserInterface::drawGameWonText() {
 	m_window.draw(gameWonText);
 }
 
+void UserInterface::togglePlayablePegs() {
+	m_showPlayablePegs = !m_showPlayablePegs;
+}
+
 void UserInterface::highlightHint(MoveByte& move) {
-	switch (m_gameLogic.getBoardType()) {
-	case BoardType::English:
-		for (Field& field : m_gameLogic.getBoard()) {
-			if (m_gameLogic.englishGridIdxMap.at(field.getPosition()) == move.from) {
-				fieldToShape[&field].setFillColor(sf::Color::Yellow);
-			}
-			if (m_gameLogic.englishGridIdxMap.at(field.getPosition()) == move.to) {
-				fieldToShape[&field].setOutlineColor(sf::Color::Yellow);
-			}
-		}
-		break;
-
-	case BoardType::European:
-		for (Field& field : m_gameLogic.getBoard()) {
-			if (m_gameLogic.europeanGridIdxMap.at(field.getPosition()) == move.from) {
-				fieldToShape[&field].setFillColor(sf::Color::Yellow);
-			}
-			if (m_gameLogic.europeanGridIdxMap.at(field.getPosition()) == move.to) {
-				fieldToShape[&field].setOutlineColor(sf::Color::Yellow);
-			}
-		}
-		break;
-	case BoardType::Asymmetric:
-		for (Field& field : m_gameLogic.getBoard()) {
-			if (m_gameLogic.asymmetricGridIdxMap.at(field.getPosition()) == move.from) {
-				fieldToShape[&field].setFillColor(sf::Color::Yellow);
-			}
-			if (m_gameLogic.asymmetricGridIdxMap.at(field.getPosition()) == move.to) {
-				fieldToShape[&field].setOutlineColor(sf::Color::Yellow);
-			}
+	// The hint is given in compact bit indices, which every field knows
+	for (Field& field : m_gameLogic.getBoard()) {
+		if (field.getBitIdx() == move.from) {
+			fieldToShape[&field].setFillColor(sf::Color::Yellow);
 		}
-		break;
-	case BoardType::SmallDiamond:
-		for (Field& field : m_gameLogic.getBoard()) {
-			if (m_gameLogic.smallDiamondGridIdxMap.at(field.getPosition()) == move.from) {
-				fieldToShape[&field].setFillColor(sf::Color::Yellow);
-			}
-			if (m_gameLogic.smallDiamondGridIdxMap.at(field.getPosition()) == move.to) {
-				fieldToShape[&field].setOutlineColor(sf::Color::Yellow);
-			}
+		if (field.getBitIdx() == move.to) {
+			fieldToShape[&field].setOutlineColor(sf::Color::Yellow);
 		}
-		break;
 	}
 }
 
@@ -208,29 +178,19 @@ void UserInterface::resetFieldToShape() {
 	fieldToShape.clear();
 	for (Field& field : m_gameLogic.getBoard()) {
 		sf::CircleShape circle(20.f); // Every game field is represented by a circle with radius 20 pixels
-		switch (m_gameLogic.getBoardType()) {
-		case BoardType::English:
-		case BoardType::European:
-		case BoardType::SmallDiamond:
-		case BoardType::Asymmetric:
-			if (field.getState() == FieldState::Occupied) {
-				circle.setFillColor(sf::Color::Blue);
-				circle.setOutlineColor(sf::Color::Black);
-				circle.setOutlineThickness(1.f);
-				circle.setPosition(sf::Vector2f(static_cast<float>(225 + field.getPosition().second * 50), static_cast<float>(225 + field.getPosition().first * 50))); // Adjust position based on the specific field
-				fieldToShape[&field] = circle; // Map the field to its circle representation
-			}
-			else if (field.getState() == FieldState::Empty) {
-				circle.setFillColor(sf::Color::Transparent);
-				circle.setOutlineColor(sf::Color::Black);
-				circle.setOutlineThickness(1.f);
-				circle.setPosition(sf::Vector2f(static_cast<float>(225 + field.getPosition().second * 50), static_cast<float>(225 + field.getPosition().first * 50)));
-				fieldToShape[&field] = circle;
-			}
-			break;
-		default:
-			throw std::runtime_error("Unsupported board type for peg solitaire.");
-			break;
+		if (field.getState() == FieldState::Occupied) {
+			circle.setFillColor(sf::Color::Blue);
+			circle.setOutlineColor(sf::Color::Black);
+			circle.setOutlineThickness(1.f);
+			circle.setPosition(sf::Vector2f(static_cast<float>(225 + field.getPosition().second * 50), static_cast<float>(225 + field.getPosition().first * 50))); // Adjust position based on the specific field
+			fieldToShape[&field] = circle; // Map the field to its circle representation
+		}
+		else if (field.getState() == FieldState::Empty) {
+			circle.setFillColor(sf::Color::Transparent);
+			circle.setOutlineColor(sf::Color::Black);
+			circle.setOutlineThickness(1.f);
+			circle.setPosition(sf::Vector2f(static_cast<float>(225 + field.getPosition().second * 50), static_cast<float>(225 + field.getPosition().first * 50)));
+			fieldToShape[&field] = circle;
 		}
 	}
 }
@@ -7,13 +7,48 @@
 //#include "Solver.cpp"
 #include <iostream>
 #include <chrono>
+#include <memory>
+#include <string>
+#include <optional>
+#include <map>
+#include <vector>
+#include <algorithm>
+#include <future>
+#include <random>
+#include <array>
+#include <variant>
+#include <filesystem>
 #include "Solver.cpp"
+#include "SolvabilityTable.h"
+#include "HintEngine.h"
+#include "BoardDefinition.h"
+
+
+/**
+	A board of the game together with the board file it was loaded from.
+*/
+struct GameBoard {
+	std::string path;
+	std::unique_ptr<const LoadedBoard> board;
+};
+
+static constexpr std::size_t kMaxSelectableBoards = 9; // boards selected by the keys 1 to 9
+
+
+/**
+	Starts the speculative search of the board shown after it changed, so the next hint is answered from the cache.
+	This also cancels the hint still computed for the previous board.
+*/
+static void presolveBoard(GameLogic& gameLogic, HintEngine& hintEngine) {
+	hintEngine.presolve(gameLogic.getLoadedBoard(), gameLogic.getSolverBoard());
+}
 
 
 /**
 	handles events such as mouse clicks and window closing.
 */
-static void handleEvents(sf::RenderWindow& window, GameLogic& gameLogic, UserInterface& ui, SoundManager& soundManager) {
+static void handleEvents(sf::RenderWindow& window, GameLogic& gameLogic, UserInterface& ui, SoundManager& soundManager, HintEngine& hintEngine,
+	std::future<HintResult>& pendingHint, const std::vector<GameBoard>& gameBoards) {
 	while (const std::optional event = window.pollEvent()) {
 		// event for closing the window
 		if (event->is<sf::Event::Closed>()) {
@@ -26,99 +61,33 @@ static void handleEvents(sf::RenderWindow& window, GameLogic& gameLogic, UserInt
 				if (keyPressed->code == sf::Keyboard::Key::Z and !gameLogic.getMoveHistory().empty()) {
 					gameLogic.undoMove();
 					ui.updateBoard(); // Update the board after undoing the move
+					presolveBoard(gameLogic, hintEngine);
 					soundManager.playUndoMoveSound();
 				}
 			}
 
-			// Change board representation
+			// Change the board to the one of the number key pressed (the boards of assets/boards in the order of their file names)
 			if (const auto* keyPressed = event->getIf<sf::Event::KeyPressed>()) {
-				if (keyPressed->code == sf::Keyboard::Key::A) {
-					gameLogic.setBoardType(BoardType::English);
-					gameLogic.resetGame();
-					ui.resetFieldToShape();
-				}
-			}
-			if (const auto* keyPressed = event->getIf<sf::Event::KeyPressed>()) {
-				if (keyPressed->code == sf::Keyboard::Key::S) {
-					gameLogic.setBoardType(BoardType::European);
-					gameLogic.resetGame();
-					ui.resetFieldToShape();
-				}
-			}
-			if (const auto* keyPressed = event->getIf<sf::Event::KeyPressed>()) {
-				if (keyPressed->code == sf::Keyboard::Key::D) {
-					gameLogic.setBoardType(BoardType::SmallDiamond);
-					gameLogic.resetGame();
-					ui.resetFieldToShape();
-				}
-			}
-			if (const auto* keyPressed = event->getIf<sf::Event::KeyPressed>()) {
-				if (keyPressed->code == sf::Keyboard::Key::F) {
-					gameLogic.setBoardType(BoardType::Asymmetric);
+				const int boardIdx = static_cast<int>(keyPressed->code) - static_cast<int>(sf::Keyboard::Key::Num1);
+				if (boardIdx >= 0 && static_cast<std::size_t>(boardIdx) < std::min(gameBoards.size(), kMaxSelectableBoards)) {
+					gameLogic.setLoadedBoard(*gameBoards[boardIdx].board);
 					gameLogic.resetGame();
 					ui.resetFieldToShape();
+					presolveBoard(gameLogic, hintEngine);
 				}
 			}
 
 			// Handle event to give a hint for the next move when H is pressed
 			if (const auto* keyPressed = event->getIf<sf::Event::KeyPressed>()) {
 				if (keyPressed->code == sf::Keyboard::Key::H) {
-					switch(gameLogic.getBoardType()) {
-					case BoardType::English:
-						{
-							uint64_t newBoard = gameLogic.convertBoardToSolverBoardFormat();
-							EnglishBoardSolver solver(newBoard);
-							std::chrono::milliseconds timeout(25000);
-							const std::chrono::time_point<std::chrono::system_clock> startTime = std::chrono::system_clock::now();
-							if (solver.solve(startTime, timeout)) {
-								std::cout << "Done computing" << std::endl;
-								std::vector<MoveByte>& moves = solver.getSolutionPath();
-								ui.highlightHint(moves[0]); // moves[0] contains the next move of the solution found
-							}
-							break;
-						}
-					case BoardType::European:
-						{
-							uint64_t newBoard = gameLogic.convertBoardToSolverBoardFormat();
-							EuropeanBoardSolver solver(newBoard);
-							std::chrono::milliseconds timeout(50000);
-							const std::chrono::time_point<std::chrono::system_clock> startTime = std::chrono::system_clock::now();
-							if (solver.solve(startTime, timeout)) {
-								std::cout << "Done computing" << std::endl;
-								std::vector<MoveByte>& moves = solver.getSolutionPath();
-								ui.highlightHint(moves[0]); // moves[0] contains the next move of the solution found
-							}
-							break;
-						}
-					case BoardType::SmallDiamond:
-						{
-							uint64_t newBoard = gameLogic.convertBoardToSolverBoardFormat();
-							SmallDiamondBoardSolver solver(newBoard);
-							std::chrono::milliseconds timeout(25000);
-							const std::chrono::time_point<std::chrono::system_clock> startTime = std::chrono::system_clock::now();
-							if (solver.solve(startTime, timeout)) {
-								std::cout << "Done computing" << std::endl;
-								std::vector<MoveByte>& moves = solver.getSolutionPath();
-								ui.highlightHint(moves[0]); // moves[0] contains the next move of the solution found
-							}
-							break;
-						}
-					case BoardType::Asymmetric:
-						{
-							uint64_t newBoard = gameLogic.convertBoardToSolverBoardFormat();
-							AsymmetricBoardSolver solver(newBoard);
-							std::chrono::milliseconds timeout(25000);
-							const std::chrono::time_point<std::chrono::system_clock> startTime = std::chrono::system_clock::now();
-							if (solver.solve(startTime, timeout)) {
-								std::cout << "Done computing" << std::endl;
-								std::vector<MoveByte>& moves = solver.getSolutionPath();
-								ui.highlightHint(moves[0]); // moves[0] contains the next move of the solution found
-							}
-							break;
-						}
-					default:
-						break;
-					}
+					// The hint is computed in the background, the game loop highlights it once it is ready
+					pendingHint = hintEngine.request(gameLogic.getLoadedBoard(), gameLogic.getSolverBoard());
+				}
+			}
+			// Handle event to outline the pegs which can jump when P is pressed
+			if (const auto* keyPressed = event->getIf<sf::Event::KeyPressed>()) {
+				if (keyPressed->code == sf::Keyboard::Key::P) {
+					ui.togglePlayablePegs();
 				}
 			}
 			// Handle mouse button pressed events to do moves
@@ -132,6 +101,7 @@ static void handleEvents(sf::RenderWindow& window, GameLogic& gameLogic, UserInt
 						if (auto* selectedField = ui.getCurrentSelectedField()) {
 							if (field->getState() == FieldState::Empty) {
 								if (gameLogic.isValidMove(*selectedField, *field)) {
+									hintEngine.cancel();
 									gameLogic.makeMove(*selectedField, *field);
 									ui.updateBoard(); // Update the board based on the move, i.e. the map of fields to their corresponding circles
 									if (gameLogic.solutionFound()) {
@@ -147,6 +117,7 @@ static void handleEvents(sf::RenderWindow& window, GameLogic& gameLogic, UserInt
 										break;
 									}
 									soundManager.playCorrectMoveSound(); // Play correct move sound (if the game was not won or lost)
+									presolveBoard(gameLogic, hintEngine);
 								} else {
 									selectedField->setState(FieldState::Occupied);
 									ui.updateBoard();
@@ -173,6 +144,7 @@ static void handleEvents(sf::RenderWindow& window, GameLogic& gameLogic, UserInt
 					if (mousePosition.x >= 10 && mousePosition.x <= 160 && mousePosition.y >= 10 && mousePosition.y <= 60) {
 						gameLogic.resetGame(); // Reset the game logic to default state
 						ui.updateBoard(); // Reset the board
+						presolveBoard(gameLogic, hintEngine);
 					}
 				}
 			}
@@ -181,22 +153,287 @@ static void handleEvents(sf::RenderWindow& window, GameLogic& gameLogic, UserInt
 }
 
 
+/**
+	Highlights the hint once the hint engine has finished it, if it still belongs to the board shown.
+*/
+static void applyFinishedHint(GameLogic& gameLogic, UserInterface& ui, std::future<HintResult>& pendingHint) {
+	if (!pendingHint.valid() || pendingHint.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+		return;
+	}
+	HintResult hint = pendingHint.get();
+	if (hint.loadedBoard != &gameLogic.getLoadedBoard() || hint.board != gameLogic.getSolverBoard()) {
+		return; // the board changed while the hint was computed
+	}
+	switch (hint.status) {
+	case HintResult::Status::Found:
+		std::cout << "Done computing" << std::endl;
+		ui.highlightHint(hint.move);
+		break;
+	case HintResult::Status::NoSolution:
+		std::cout << "No solution possible anymore." << std::endl;
+		break;
+	case HintResult::Status::AlreadySolved:
+		std::cout << "The board is already solved, no hint needed." << std::endl;
+		break;
+	case HintResult::Status::TimedOut:
+		std::cout << "No solution found in time." << std::endl;
+		break;
+	case HintResult::Status::Cancelled:
+		return;
+	}
+	if (hint.stats.nodesExplored != 0) {
+		std::cout << hint.stats << std::endl;
+	}
+}
+
+
 /**
 	Implements the game loop that handles events, updates the game state, and renders the UI.
+	Hints are computed by the hint engine in the background, so rendering and input never wait for the solver.
 */
-static void gameLoop(GameLogic& gameLogic, UserInterface& ui, SoundManager& soundManager) {
+static void gameLoop(GameLogic& gameLogic, UserInterface& ui, SoundManager& soundManager, HintEngine& hintEngine,
+	const std::vector<GameBoard>& gameBoards) {
 	sf::RenderWindow& window = ui.getRenderWindow();
+	std::future<HintResult> pendingHint;
 
 	while (window.isOpen()) {
 		ui.render();
-		handleEvents(window, gameLogic, ui, soundManager);
+		handleEvents(window, gameLogic, ui, soundManager, hintEngine, pendingHint, gameBoards);
+		applyFinishedHint(gameLogic, ui, pendingHint);
+	}
+}
+
+/**
+	Loads the boards of the game, i.e. the board files whose grid fits into the 64 bit boards of GameLogic.
+	Larger boards such as Wiegleb's board can only be solved with --solve-board, so they are skipped like board files with errors.
+	\param paths The paths of the board files
+	\return The loaded boards in the order of the paths
+*/
+static std::vector<GameBoard> loadGameBoards(const std::vector<std::string>& paths) {
+	std::vector<GameBoard> gameBoards;
+	for (const std::string& path : paths) {
+		try {
+			AnyLoadedBoard loadedBoard = BoardDefinition::load(path);
+			if (auto* board = std::get_if<std::unique_ptr<const LoadedBoard>>(&loadedBoard)) {
+				gameBoards.push_back(GameBoard{ path, std::move(*board) });
+			} else {
+				std::cout << path << " needs more than 64 bits and can only be solved with --solve-board." << std::endl;
+			}
+		} catch (const std::exception& error) {
+			std::cout << error.what() << std::endl;
+		}
+	}
+	return gameBoards;
+}
+
+/**
+	Generates the solvability tables of boards of the game, which may take a long time for the larger boards.
+	\param paths The paths of the board files to generate the tables for (all board files of assets/boards if empty)
+*/
+static void generateTables(const std::vector<std::string>& paths) {
+	for (const GameBoard& gameBoard : loadGameBoards(paths.empty() ? BoardDefinition::listBoardFiles(BoardDefinition::kBoardDirectory) : paths)) {
+		const LoadedBoard& board = *gameBoard.board;
+		const uint64_t startBoard = board.tables.startBoard;
+		const std::string path = SolvabilityTable::defaultPath(gameBoard.path);
+
+		const std::chrono::time_point<std::chrono::steady_clock> startTime = std::chrono::steady_clock::now();
+		LevelEnumerator enumerator(board.layout);
+		const SolvabilityTable::Levels levels = SolvabilityTable::enumerateWinnable(enumerator, startBoard);
+		SolvabilityTable::write(path, board, startBoard, levels);
+		for (const LevelEnumerator::LevelStats& stats : enumerator.getStats()) {
+			std::cout << stats << std::endl;
+		}
+
+		std::size_t boardCount = 0;
+		for (const std::vector<uint64_t>& level : levels) {
+			boardCount += level.size();
+		}
+		const auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - startTime);
+		std::cout << "Wrote " << boardCount << " winnable boards of " << board.name << " to " << path << " in " << duration.count() << " ms using "
+			<< enumerator.getThreadCount() << " threads" << std::endl;
+	}
+}
+
+/**
+	Compares the search strategies of the solver on one board and prints the average number of nodes
+	explored until the first solution was found. The boards are reached by random moves from the initial board,
+	only boards solved by all strategies within the time limit are counted.
+	\tparam BoardTraits The traits of the board (see BoardTraits.h)
+	\param name The name of the board
+	\param sampleCount The number of random boards
+*/
+template <typename BoardTraits>
+static void compareSearchStrategies(const std::string& name, std::size_t sampleCount) {
+	using Board = typename Solver<BoardTraits>::Board;
+	static constexpr std::array<std::pair<SearchStrategy, const char*>, 3> strategies{ {
+		{ SearchStrategy::DepthFirst, "depth-first" },
+		{ SearchStrategy::OrderedDepthFirst, "ordered depth-first" },
+		{ SearchStrategy::Beam, "beam" },
+	} };
+	const auto& layout = BoardTraits::layout();
+	std::mt19937 random(42); // the same boards in every run
+
+	std::array<uint64_t, strategies.size()> nodeSums{};
+	std::size_t solvedCount = 0;
+	for (std::size_t sample = 0; sample < sampleCount; ++sample) {
+		// Up to two thirds of the pegs are removed by random moves
+		Board gridBoard = layout.toGridBoard(BoardTraits::kTables.startBoard);
+		const unsigned int moveCount = static_cast<unsigned int>(random() % (pegCount(gridBoard) * 2 / 3));
+		for (unsigned int moveIdx = 0; moveIdx < moveCount; ++moveIdx) {
+			const auto jumps = layout.legalJumps(gridBoard);
+			std::vector<MoveByte> moves;
+			for (std::size_t direction = 0; direction < jumps.size(); ++direction) {
+				for (Board origins = jumps[direction]; origins != Board{}; origins = withoutLowestBit(origins)) {
+					moves.push_back(layout.gridMove(lowestBitIndex(origins), direction));
+				}
+			}
+			if (moves.empty()) {
+				break;
+			}
+			const MoveByte& move = moves[random() % moves.size()];
+			gridBoard ^= singleBit<Board>(move.from) | singleBit<Board>(move.over) | singleBit<Board>(move.to);
+		}
+		Board board{};
+		for (; gridBoard != Board{}; gridBoard = withoutLowestBit(gridBoard)) {
+			board |= singleBit<Board>(layout.gridToBitIdx[lowestBitIndex(gridBoard)]);
+		}
+
+		std::array<uint64_t, strategies.size()> nodes{};
+		bool isSolvedByAll = true;
+		for (std::size_t strategyIdx = 0; strategyIdx < strategies.size(); ++strategyIdx) {
+			SearchBudget budget(std::chrono::seconds(5));
+			Solver<BoardTraits> solver(board);
+			solver.setSearchStrategy(strategies[strategyIdx].first);
+			const SolveResult result = solver.solve(budget);
+			nodes[strategyIdx] = result.nodesExplored;
+			isSolvedByAll = isSolvedByAll && result.isSolved();
+		}
+		if (isSolvedByAll) {
+			++solvedCount;
+			for (std::size_t strategyIdx = 0; strategyIdx < strategies.size(); ++strategyIdx) {
+				nodeSums[strategyIdx] += nodes[strategyIdx];
+			}
+		}
+	}
+
+	std::cout << name << " (" << solvedCount << " of " << sampleCount << " boards solved):";
+	for (std::size_t strategyIdx = 0; strategyIdx < strategies.size(); ++strategyIdx) {
+		std::cout << " " << strategies[strategyIdx].second << " " << (solvedCount == 0 ? 0 : nodeSums[strategyIdx] / solvedCount) << " nodes";
+	}
+	std::cout << std::endl;
+}
+
+/**
+	Compares the search strategies of the solver on every built-in board and on Wiegleb's board, whose grid needs more than 64 bits.
+	\param sampleCount The number of random boards per board
+*/
+static void compareSearchStrategies(std::size_t sampleCount) {
+	compareSearchStrategies<EnglishBoardTraits>("English", sampleCount);
+	compareSearchStrategies<EuropeanBoardTraits>("European", sampleCount);
+	compareSearchStrategies<AsymmetricBoardTraits>("Asymmetric", sampleCount);
+	compareSearchStrategies<SmallDiamondBoardTraits>("Small diamond", sampleCount);
+	compareSearchStrategies<WieglebBoardTraits>("Wiegleb", sampleCount);
+}
+
+/**
+	Solves the initial board of a board loaded from a file and prints the solution path.
+	\tparam GridBoard The bitboard type of the board
+	\param board The loaded board
+*/
+template <typename GridBoard>
+static void solveLoadedBoard(const BasicLoadedBoard<GridBoard>& board) {
+	const std::chrono::time_point<std::chrono::steady_clock> startTime = std::chrono::steady_clock::now();
+	Solver<LoadedBoardTraits<GridBoard>> solver(board.layout, board.tables.startBoard);
+	SearchBudget budget(std::chrono::minutes(5));
+	const SolveResult result = solver.solve(budget);
+	const auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - startTime);
+
+	std::cout << board.name << " (" << board.tables.fieldCount << " fields, " << board.tables.moveCount << " jumps, "
+		<< board.layout.symmetries.size() << " symmetries): ";
+	switch (result.status) {
+	case SolveResult::Status::Solved:
+		std::cout << "solved in " << duration.count() << " ms" << std::endl;
+		for (const MoveByte& move : solver.getSolutionPath()) {
+			const auto [fromRow, fromCol] = board.tables.position(move.from);
+			const auto [toRow, toCol] = board.tables.position(move.to);
+			std::cout << "(" << fromRow << ", " << fromCol << ") -> (" << toRow << ", " << toCol << ")" << std::endl;
+		}
+		break;
+	case SolveResult::Status::Unsolvable:
+		std::cout << "no solution exists (" << duration.count() << " ms)" << std::endl;
+		break;
+	default:
+		std::cout << "no solution found within the time limit" << std::endl;
+		break;
 	}
+	std::cout << solver.getStats() << std::endl;
 }
 
-int main() {
-	GameLogic gameLogic{}; // Initialize the game logic
+/**
+	Loads board files, whose compiled tables are cached under assets/tables, and solves their initial boards.
+	\param paths The paths of the board files
+*/
+static void solveBoardFiles(const std::vector<std::string>& paths) {
+	for (const std::string& path : paths) {
+		try {
+			const std::chrono::time_point<std::chrono::steady_clock> startTime = std::chrono::steady_clock::now();
+			const AnyLoadedBoard loadedBoard = BoardDefinition::load(path);
+			const auto duration = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime);
+			std::cout << "Loaded " << path << " in " << duration.count() << " us" << std::endl;
+			std::visit([](const auto& board) { solveLoadedBoard(*board); }, loadedBoard);
+		} catch (const std::exception& error) {
+			std::cout << error.what() << std::endl;
+		}
+	}
+}
+
+int main(int argc, char* argv[]) {
+	if (argc > 1 && std::string(argv[1]) == "--generate-tables") {
+		generateTables(std::vector<std::string>(argv + 2, argv + argc));
+		return 0;
+	}
+	if (argc > 1 && std::string(argv[1]) == "--compare-strategies") {
+		compareSearchStrategies(argc > 2 ? std::stoul(argv[2]) : 100);
+		return 0;
+	}
+	if (argc > 1 && std::string(argv[1]) == "--solve-board") {
+		solveBoardFiles(std::vector<std::string>(argv + 2, argv + argc));
+		return 0;
+	}
+
+	// The game plays the boards of assets/boards, the English board is shown first
+	std::vector<GameBoard> gameBoards;
+	try {
+		gameBoards = loadGameBoards(BoardDefinition::listBoardFiles(BoardDefinition::kBoardDirectory));
+	} catch (const std::filesystem::filesystem_error& error) {
+		std::cout << error.what() << std::endl;
+	}
+	if (gameBoards.empty()) {
+		std::cout << "No board to play in " << BoardDefinition::kBoardDirectory << "." << std::endl;
+		return 1;
+	}
+	const auto startBoard = std::find_if(gameBoards.begin(), gameBoards.end(), [](const GameBoard& gameBoard) {
+		return std::filesystem::path(gameBoard.path).filename() == "english.board";
+	});
+	for (std::size_t boardIdx = 0; boardIdx < std::min(gameBoards.size(), kMaxSelectableBoards); ++boardIdx) {
+		std::cout << "Press " << boardIdx + 1 << " to play " << gameBoards[boardIdx].board->name << std::endl;
+	}
+
+	// Opening a table only maps the file, the levels are read from disk by the hints using them.
+	// Without a table the hints of the board are computed by the solver
+	SolvabilityTables solvabilityTables;
+	for (const GameBoard& gameBoard : gameBoards) {
+		try {
+			solvabilityTables.emplace(gameBoard.board.get(), std::make_unique<SolvabilityTable>(SolvabilityTable::defaultPath(gameBoard.path), *gameBoard.board));
+		} catch (const std::runtime_error& error) {
+			std::cout << error.what() << " Hints are computed by the solver." << std::endl;
+		}
+	}
+
+	GameLogic gameLogic(*(startBoard != gameBoards.end() ? startBoard : gameBoards.begin())->board); // Initialize the game logic
 	UserInterface ui(gameLogic); // Initialize the user interface with the game logic
 	SoundManager soundManager; // Initialize the sound manager
+	HintEngine hintEngine(solvabilityTables); // Starts the background thread computing the hints
 
-	gameLoop(gameLogic, ui, soundManager); // Start the game loop
-}
\ No newline at end of file
+	gameLoop(gameLogic, ui, soundManager, hintEngine, gameBoards); // Start the game loop
+}